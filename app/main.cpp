@@ -1,14 +1,223 @@
 /**
  * @file main.cpp
  * @author Jerry Pittman, Jr. (jpittma1@umd.edu)
- * @brief
+ * @brief Batch planning CLI: plans a stream of move requests in parallel
  * @version 0.1
  * @date 2023-10-10
  *
  * @copyright Copyright (c) 2023
  *
+ * @note Usage: shell-app [--input <file|->] [--output <file>]
+ * [--threads <n>] [--batch <n>] [--verbose]
+ *
+ * One request per line, '#' starts a comment:
+ *   move  q1 q2 q3 q4 q5 q6  x y z     target position in the base frame
+ *   delta q1 q2 q3 q4 q5 q6  dx dy dz  target relative to the start pose
+ * q are the start joint angles in radians, positions in metres, the
+ * orientation of the start pose is held. Trajectories go to a binary
+ * trajectory file, one segment per valid request in input order (empty if
+ * planning failed).
  */
 
-#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "include/BatchPlanner.hpp"
+#include "include/TrajectoryFile.hpp"
+
+namespace {
+struct Settings {
+  std::string inputPath = "-";
+  std::string outputPath;
+  size_t numThreads = 0;
+  // @brief Requests planned together, bounds memory for long streams
+  size_t batchSize = 256;
+  bool verbose = false;
+};
+
+const char *statusName(a3c::PlanStatus status) {
+  switch (status) {
+    case a3c::PlanStatus::kSuccess:
+      return "ok";
+    case a3c::PlanStatus::kGoalNotReached:
+      return "goal-not-reached";
+    case a3c::PlanStatus::kNonFinite:
+      return "non-finite";
+    case a3c::PlanStatus::kFailed:
+      return "failed";
+    case a3c::PlanStatus::kCancelled:
+      return "cancelled";
+    case a3c::PlanStatus::kRejected:
+      return "rejected";
+  }
+  return "unknown";
+}
+
+/**
+ * @brief Parse one request line and append it to jobs
+ * @return false if the line is malformed, error says why
+ */
+bool parseRequest(const std::string &line, const a3c::ForwardKinematics &fk,
+                  a3c::PlanJobs &jobs, std::string &error) {
+  std::istringstream in(line);
+  std::string kind;
+  in >> kind;
+  if (kind != "move" && kind != "delta") {
+    error = "unknown request '" + kind + "'";
+    return false;
+  }
+  a3c::JointAngles startAngles;
+  for (auto &q : startAngles) {
+    in >> q;
+  }
+  Eigen::Vector3d position;
+  in >> position.x() >> position.y() >> position.z();
+  std::string trailing;
+  if (!in || (in >> trailing)) {
+    error = "expected 6 joint angles and 3 coordinates";
+    return false;
+  }
+  const a3c::Pose currentPose = fk.fk(startAngles);
+  a3c::Pose targetPose = currentPose;
+  targetPose.position =
+      kind == "move" ? position : currentPose.position + position;
+  jobs.push_back({startAngles, currentPose, targetPose});
+  return true;
+}
+
+void printUsage(const char *argv0) {
+  std::cerr << "usage: " << argv0
+            << " [--input <file|->] [--output <file>] [--threads <n>]"
+               " [--batch <n>] [--verbose]"
+            << std::endl;
+}
+
+bool parseSettings(int argc, char **argv, Settings &settings) {
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--input") && hasValue) {
+      settings.inputPath = argv[++i];
+    } else if (!std::strcmp(argv[i], "--output") && hasValue) {
+      settings.outputPath = argv[++i];
+    } else if (!std::strcmp(argv[i], "--threads") && hasValue) {
+      settings.numThreads = std::strtoul(argv[++i], nullptr, 10);
+    } else if (!std::strcmp(argv[i], "--batch") && hasValue) {
+      settings.batchSize = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+    } else if (!std::strcmp(argv[i], "--verbose")) {
+      settings.verbose = true;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  Settings settings;
+  if (!parseSettings(argc, argv, settings)) {
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  std::ifstream inputFile;
+  if (settings.inputPath != "-") {
+    inputFile.open(settings.inputPath);
+    if (!inputFile) {
+      std::cerr << "could not open " << settings.inputPath << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::istream &input = settings.inputPath == "-" ? std::cin : inputFile;
+
+  const a3c::ForwardKinematics fk;
+  const a3c::IKOptions options;
+  a3c::TrajectoryWriter writer;
+  if (!settings.outputPath.empty() &&
+      !writer.open(settings.outputPath, fk)) {
+    std::cerr << "could not create " << settings.outputPath << std::endl;
+    return EXIT_FAILURE;
+  }
+  a3c::BatchPlanner planner(options, settings.numThreads);
+
+  std::vector<double> latencies;
+  size_t invalid = 0;
+  size_t failed = 0;
+  size_t waypoints = 0;
+  a3c::PlanJobs jobs;
+  std::vector<size_t> lineNumbers;
+  auto planBatch = [&] {
+    const auto results = planner.plan(jobs);
+    for (size_t i = 0; i < results.size(); ++i) {
+      const auto &result = results[i];
+      latencies.push_back(result.solveSecs);
+      waypoints += result.trajectory.size();
+      failed += result.status != a3c::PlanStatus::kSuccess;
+      if (writer.isOpen()) {
+        writer.writeSegment(result.status == a3c::PlanStatus::kSuccess
+                                ? result.trajectory
+                                : std::vector<a3c::JointAngles>());
+      }
+      if (settings.verbose) {
+        std::cout << "line " << lineNumbers[i] << ": "
+                  << statusName(result.status) << ", "
+                  << result.trajectory.size() << " waypoints, "
+                  << result.solveSecs * 1E3 << " ms" << std::endl;
+      }
+    }
+    jobs.clear();
+    lineNumbers.clear();
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  std::string line;
+  size_t lineNumber = 0;
+  while (std::getline(input, line)) {
+    ++lineNumber;
+    line = line.substr(0, line.find('#'));
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    std::string error;
+    if (!parseRequest(line, fk, jobs, error)) {
+      std::cerr << "line " << lineNumber << ": " << error << std::endl;
+      ++invalid;
+      continue;
+    }
+    lineNumbers.push_back(lineNumber);
+    if (jobs.size() == settings.batchSize) {
+      planBatch();
+    }
+  }
+  planBatch();
+  const double wallSecs = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+  if (writer.isOpen() && !writer.close()) {
+    std::cerr << "could not write " << settings.outputPath << std::endl;
+    return EXIT_FAILURE;
+  }
 
-int main() { return 0; }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    return latencies.empty()
+               ? 0.0
+               : latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+  };
+  std::cout << latencies.size() << " requests (" << failed << " failed, "
+            << invalid << " invalid), " << waypoints << " waypoints, "
+            << planner.numThreads() << " threads" << std::endl
+            << "wall " << wallSecs << " s, "
+            << latencies.size() / std::max(wallSecs, 1E-9) << " requests/s"
+            << std::endl
+            << "latency ms: p50 " << percentile(0.5) * 1E3 << ", p95 "
+            << percentile(0.95) * 1E3 << ", max " << percentile(1.0) * 1E3
+            << std::endl;
+  return failed == 0 && invalid == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file AllocationCounter.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Interposes the glibc allocator to count heap allocations
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "bench/AllocationCounter.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+
+namespace {
+std::atomic<size_t> gAllocations{0};
+}  // namespace
+
+#if defined(__GLIBC__)
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+
+/**
+ * @brief Counting malloc, forwards to glibc
+ */
+void *malloc(size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+/**
+ * @brief Counting calloc, forwards to glibc
+ */
+void *calloc(size_t count, size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+/**
+ * @brief Counting realloc, forwards to glibc
+ */
+void *realloc(void *ptr, size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(ptr, size);
+}
+/**
+ * @brief Counting memalign, forwards to glibc
+ */
+void *memalign(size_t alignment, size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+/**
+ * @brief Counting aligned_alloc, the aligned operator new of libstdc++ ends
+ * up here
+ */
+void *aligned_alloc(size_t alignment, size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+/**
+ * @brief Counting posix_memalign, same checks as glibc
+ */
+int posix_memalign(void **ptr, size_t alignment, size_t size) {
+  if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0 ||
+      alignment == 0) {
+    return EINVAL;
+  }
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  void *memory = __libc_memalign(alignment, size);
+  if (memory == nullptr) {
+    return ENOMEM;
+  }
+  *ptr = memory;
+  return 0;
+}
+}
+#else
+#include <new>
+/**
+ * @brief Counting operator new, used where the C allocator cannot be
+ * interposed. Allocations made through malloc directly are not seen here.
+ */
+void *operator new(size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+#endif
+
+namespace a3c {
+namespace bench {
+size_t allocationCount() noexcept {
+  return gAllocations.load(std::memory_order_relaxed);
+}
+}  // namespace bench
+}  // namespace a3c
@@ -0,0 +1,29 @@
+/**
+ * @file AllocationCounter.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Process wide heap allocation counter used by benchmarks and tests
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef AllocationCounter_HPP
+#define AllocationCounter_HPP
+
+#include <cstddef>
+
+namespace a3c {
+namespace bench {
+/**
+ * @brief Number of heap allocations (malloc/calloc/realloc, the aligned
+ * allocators and operator new) made by the process so far
+ * @note Linking AllocationCounter interposes the C allocator, so allocations
+ * made by Eigen (which calls malloc directly) are counted as well
+ */
+size_t allocationCount() noexcept;
+}  // namespace bench
+}  // namespace a3c
+
+#endif
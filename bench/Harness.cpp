@@ -0,0 +1,120 @@
+/**
+ * @file Harness.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Reporting and baseline comparison for the benchmark harness
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "bench/Harness.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+namespace a3c {
+namespace bench {
+namespace {
+/**
+ * @brief Extract the value following "key": on a line written by writeJson
+ */
+bool findField(const std::string &line, const std::string &key,
+               std::string *value) {
+  const std::string token = "\"" + key + "\": ";
+  auto pos = line.find(token);
+  if (pos == std::string::npos) {
+    return false;
+  }
+  pos += token.size();
+  if (pos < line.size() && line[pos] == '"') {
+    auto end = line.find('"', pos + 1);
+    if (end == std::string::npos) {
+      return false;
+    }
+    *value = line.substr(pos + 1, end - pos - 1);
+    return true;
+  }
+  auto end = line.find_first_of(",}", pos);
+  *value = line.substr(pos, end - pos);
+  return true;
+}
+}  // namespace
+
+bool Suite::setMaxError(const std::string &name, double maxError) noexcept {
+  for (auto &result : mResults) {
+    if (result.name == name) {
+      result.maxError = maxError;
+      return true;
+    }
+  }
+  return false;
+}
+
+void printResult(std::ostream &os, const Result &result) {
+  os << std::left << std::setw(40) << result.name << std::right
+     << std::setw(14) << std::fixed << std::setprecision(1) << result.nsPerCall
+     << " ns/call" << std::setw(10) << std::setprecision(2)
+     << result.allocationsPerCall << " allocs/call" << std::setw(16)
+     << std::setprecision(0) << result.itemsPerSec << " " << result.itemUnit
+     << "/s" << std::endl;
+}
+
+bool writeJson(const std::string &path, const std::vector<Result> &results) {
+  std::ofstream out(path);
+  if (!out) {
+    return false;
+  }
+  out << "{\n  \"schema\": 1,\n  \"results\": [\n";
+  out << std::setprecision(9);
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto &r = results[i];
+    out << "    {\"name\": \"" << r.name << "\", \"calls\": " << r.calls
+        << ", \"ns_per_call\": " << r.nsPerCall
+        << ", \"allocations_per_call\": " << r.allocationsPerCall
+        << ", \"items_per_sec\": " << r.itemsPerSec << ", \"item_unit\": \""
+        << r.itemUnit << "\"";
+    if (r.maxError >= 0) {
+      out << ", \"max_error\": " << r.maxError;
+    }
+    out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+int compareWithBaseline(std::ostream &os, const std::string &path,
+                        const std::vector<Result> &results, double threshold) {
+  std::ifstream in(path);
+  if (!in) {
+    return -1;
+  }
+  std::map<std::string, double> baseline;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::string name;
+    std::string nsPerCall;
+    if (findField(line, "name", &name) &&
+        findField(line, "ns_per_call", &nsPerCall)) {
+      baseline[name] = std::stod(nsPerCall);
+    }
+  }
+  int regressions = 0;
+  for (const auto &result : results) {
+    auto it = baseline.find(result.name);
+    if (it == baseline.end() || it->second <= 0) {
+      continue;
+    }
+    double ratio = result.nsPerCall / it->second;
+    bool regressed = ratio > 1 + threshold;
+    regressions += regressed ? 1 : 0;
+    os << (regressed ? "REGRESSION " : "ok         ") << std::left
+       << std::setw(40) << result.name << std::right << std::fixed
+       << std::setprecision(3) << ratio << "x baseline" << std::endl;
+  }
+  return regressions;
+}
+}  // namespace bench
+}  // namespace a3c
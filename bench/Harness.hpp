@@ -0,0 +1,165 @@
+/**
+ * @file Harness.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Small timing harness for the kinematics benchmark suite
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef Harness_HPP
+#define Harness_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/AllocationCounter.hpp"
+
+namespace a3c {
+namespace bench {
+/**
+ * @brief Measured figures of one benchmark case
+ */
+struct Result {
+  std::string name;
+  size_t calls;               // @note calls per repetition
+  double nsPerCall;           // @note fastest repetition
+  double allocationsPerCall;  // @note averaged over all repetitions
+  double itemsPerSec;         // @note e.g. waypoints/sec for linearIK
+  std::string itemUnit;
+  double maxError = -1;  // @note worst deviation from the double precision
+                         // result, negative when the case has none
+};
+
+/**
+ * @brief Knobs shared by every case of a run
+ */
+struct Options {
+  double minTimeSecs = 0.25;
+  size_t repetitions = 5;
+  std::string filter;
+};
+
+/**
+ * @brief Keeps the compiler from discarding a computed value
+ */
+template <typename T>
+inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * @brief Collection of benchmark cases, each case runs as soon as it is added
+ */
+class Suite {
+ public:
+  explicit Suite(const Options &options) noexcept : options(options) {}
+  /**
+   * @brief Time body and record the result
+   * @param name Unique case name, used to match against a baseline
+   * @param itemUnit What body processes, reported as itemUnit/sec
+   * @param body Callable taking the call index and returning the number of
+   * items it processed
+   */
+  template <typename F>
+  void add(const std::string &name, const std::string &itemUnit, F &&body);
+  // @brief Whether the filter lets case name run, so setup that only a
+  // filtered out case needs can be skipped
+  bool selects(const std::string &name) const noexcept {
+    return name.find(options.filter) != std::string::npos;
+  }
+  const std::vector<Result> &results() const noexcept { return mResults; }
+  // @brief Record the accuracy of case name, false if it did not run
+  bool setMaxError(const std::string &name, double maxError) noexcept;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  Options options;
+  std::vector<Result> mResults;
+};
+
+/**
+ * @brief Print one result as a table row
+ */
+void printResult(std::ostream &os, const Result &result);
+/**
+ * @brief Write results as JSON, one result object per line
+ * @note max_error is written only for cases that recorded one
+ * @return false if the file could not be written
+ */
+bool writeJson(const std::string &path, const std::vector<Result> &results);
+/**
+ * @brief Compare results with a JSON file produced by writeJson
+ * @param threshold Allowed relative slowdown in ns/call, e.g. 0.1 for 10%
+ * @return Number of regressed cases, or -1 if the baseline is unreadable
+ */
+int compareWithBaseline(std::ostream &os, const std::string &path,
+                        const std::vector<Result> &results, double threshold);
+
+template <typename F>
+void Suite::add(const std::string &name, const std::string &itemUnit,
+                F &&body) {
+  if (!selects(name)) {
+    return;
+  }
+  auto secondsSince = [](Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  };
+  // Calibrate the call count so one repetition takes its share of minTime,
+  // this doubles as warm up.
+  const double repetitionSecs =
+      options.minTimeSecs / static_cast<double>(options.repetitions);
+  size_t calls = 1;
+  for (;;) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < calls; ++i) {
+      doNotOptimize(body(i));
+    }
+    double elapsed = secondsSince(start);
+    if (elapsed >= repetitionSecs || calls >= (size_t{1} << 30)) {
+      break;
+    }
+    calls = elapsed <= 0 ? calls * 10
+                         : std::max(calls + 1, static_cast<size_t>(
+                                                   1.2 * calls *
+                                                   repetitionSecs / elapsed));
+  }
+  double bestSecs = 0;
+  double bestItems = 0;
+  size_t allocations = 0;
+  for (size_t rep = 0; rep < options.repetitions; ++rep) {
+    size_t items = 0;
+    auto allocationsBefore = allocationCount();
+    auto start = Clock::now();
+    for (size_t i = 0; i < calls; ++i) {
+      items += body(i);
+    }
+    double elapsed = secondsSince(start);
+    allocations += allocationCount() - allocationsBefore;
+    if (rep == 0 || elapsed < bestSecs) {
+      bestSecs = elapsed;
+      bestItems = static_cast<double>(items);
+    }
+  }
+  Result result;
+  result.name = name;
+  result.calls = calls;
+  result.nsPerCall = bestSecs * 1e9 / static_cast<double>(calls);
+  result.allocationsPerCall =
+      static_cast<double>(allocations) /
+      static_cast<double>(calls * options.repetitions);
+  result.itemsPerSec = bestSecs > 0 ? bestItems / bestSecs : 0;
+  result.itemUnit = itemUnit;
+  printResult(std::cout, result);
+  mResults.push_back(result);
+}
+}  // namespace bench
+}  // namespace a3c
+
+#endif
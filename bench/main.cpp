@@ -0,0 +1,752 @@
+/**
+ * @file main.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Benchmark suite for the Kinematics library
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * @note Usage: kinematics-bench [--filter <substr>] [--min-time <secs>]
+ * [--json <file>] [--baseline <file>] [--threshold <fraction>]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench/Harness.hpp"
+#include "include/AnalyticalIK.hpp"
+#include "include/BatchPlanner.hpp"
+#include "include/ForwardKinematics.hpp"
+#include "include/IncrementalForwardKinematics.hpp"
+#include "include/Instrumentation.hpp"
+#include "include/InverseKinematics.hpp"
+#include "include/KinematicChain.hpp"
+#include "include/PlanningService.hpp"
+#include "include/PlanningSocket.hpp"
+#include "include/SamplingPlanner.hpp"
+#include "include/SeedIndex.hpp"
+#include "include/SelfCollision.hpp"
+#include "include/TimeParameterization.hpp"
+#include "include/TrajectoryCompression.hpp"
+#include "include/TrajectoryFile.hpp"
+
+namespace {
+using a3c::JointAngles;
+using a3c::Pose;
+using PoseVector = std::vector<Pose, Eigen::aligned_allocator<Pose>>;
+
+// @brief Well conditioned configuration used as the centre of IK seeds
+const JointAngles kNominalAngles = {
+    {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+constexpr size_t kSampleCount = 1024;
+
+/**
+ * @brief Uniformly random joint configurations in [-pi, pi)
+ */
+std::vector<JointAngles> randomJointAngles(std::mt19937 *rng, size_t count) {
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  std::vector<JointAngles> samples(count);
+  for (auto &ja : samples) {
+    for (auto &q : ja) {
+      q = angle(*rng);
+    }
+  }
+  return samples;
+}
+
+/**
+ * @brief A linear move request: seed angles, start pose and target pose
+ */
+struct Move {
+  JointAngles seed;
+  PoseVector poses;  // @note {current, target}
+};
+
+/**
+ * @brief Random moves of a fixed Cartesian length around kNominalAngles,
+ * reorienting by rotationRadians about a random axis
+ */
+std::vector<Move> randomMoves(std::mt19937 *rng, size_t count,
+                              double lengthMetres,
+                              double rotationRadians = 0) {
+  std::uniform_real_distribution<double> perturbation(-0.2, 0.2);
+  std::normal_distribution<double> direction(0.0, 1.0);
+  a3c::ForwardKinematics fk;
+  std::vector<Move> moves(count);
+  for (auto &move : moves) {
+    move.seed = kNominalAngles;
+    for (auto &q : move.seed) {
+      q += perturbation(*rng);
+    }
+    auto current = fk.fk(move.seed);
+    Eigen::Vector3d delta(direction(*rng), direction(*rng), direction(*rng));
+    auto target = current;
+    target.position += lengthMetres * delta.normalized();
+    if (rotationRadians != 0) {
+      Eigen::Vector3d axis(direction(*rng), direction(*rng), direction(*rng));
+      target.orientation =
+          Eigen::AngleAxisd(rotationRadians, axis.normalized()) *
+          target.orientation;
+    }
+    move.poses = {current, target};
+  }
+  return moves;
+}
+
+/**
+ * @brief Joint angles rounded to single precision
+ */
+std::vector<a3c::JointAnglesF> toFloat(
+    const std::vector<a3c::JointAngles> &samples) {
+  std::vector<a3c::JointAnglesF> samplesF(samples.size());
+  for (size_t i = 0; i < samples.size(); ++i) {
+    std::copy(samples[i].begin(), samples[i].end(), samplesF[i].begin());
+  }
+  return samplesF;
+}
+
+/**
+ * @brief Single precision FK on the same samples, each case records its worst
+ * position error against double FK in the results
+ */
+void addFloatForwardKinematicsCases(
+    a3c::bench::Suite *suite, const std::vector<a3c::JointAngles> &samples,
+    const a3c::JointAnglesBatch &batch) {
+  a3c::ForwardKinematics fk;
+  const auto samplesF = toFloat(samples);
+  suite->add("fk/random-float", "poses", [&](size_t i) {
+    auto pose = fk.fk(samplesF[i % kSampleCount]);
+    a3c::bench::doNotOptimize(pose);
+    return size_t{1};
+  });
+  const a3c::A3CChainF chain;
+  suite->add("chainFk/random-float", "poses", [&](size_t i) {
+    auto pose = chain.fk(samplesF[i % kSampleCount]);
+    a3c::bench::doNotOptimize(pose);
+    return size_t{1};
+  });
+  const a3c::JointAnglesBatchF batchF = batch.cast<float>();
+  a3c::PoseBatchF posesF;
+  suite->add("fkBatch/random-float", "poses", [&](size_t) {
+    fk.fkBatch(batchF, posesF);
+    a3c::bench::doNotOptimize(posesF);
+    return kSampleCount;
+  });
+  if (!suite->selects("fk/random-float") &&
+      !suite->selects("chainFk/random-float") &&
+      !suite->selects("fkBatch/random-float")) {
+    return;
+  }
+  fk.fkBatch(batchF, posesF);
+  double worstFk = 0;
+  double worstChain = 0;
+  double worstBatch = 0;
+  for (size_t i = 0; i < kSampleCount; ++i) {
+    const Eigen::Vector3d expected = fk.fk(samples[i]).position;
+    auto errorOf = [&](const Eigen::Vector3f &position) {
+      return (position.cast<double>() - expected).norm();
+    };
+    worstFk = std::max(worstFk, errorOf(fk.fk(samplesF[i]).position));
+    worstChain = std::max(worstChain, errorOf(chain.fk(samplesF[i]).position));
+    worstBatch =
+        std::max(worstBatch, errorOf(posesF.positions.row(i).transpose()));
+  }
+  suite->setMaxError("fk/random-float", worstFk);
+  suite->setMaxError("chainFk/random-float", worstChain);
+  suite->setMaxError("fkBatch/random-float", worstBatch);
+  std::cout << std::scientific << std::setprecision(2)
+            << "float accuracy: fk " << worstFk * 1E3 << " mm, chainFk "
+            << worstChain * 1E3 << " mm, fkBatch " << worstBatch * 1E3
+            << " mm worst position error" << std::endl
+            << std::defaultfloat;
+}
+
+void addForwardKinematicsCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  const auto samples = randomJointAngles(rng, kSampleCount);
+  a3c::ForwardKinematics fk;
+  suite->add("fk/random", "poses", [&](size_t i) {
+    auto pose = fk.fk(samples[i % kSampleCount]);
+    a3c::bench::doNotOptimize(pose);
+    return size_t{1};
+  });
+  const a3c::A3CChain chain;
+  suite->add("chainFk/random", "poses", [&](size_t i) {
+    auto pose = chain.fk(samples[i % kSampleCount]);
+    a3c::bench::doNotOptimize(pose);
+    return size_t{1};
+  });
+  // Only joints 4-6 change between calls, as in a wrist sweep
+  a3c::IncrementalForwardKinematics incremental(fk);
+  auto wristSweep = samples;
+  for (auto &ja : wristSweep) {
+    std::copy(kNominalAngles.begin(), kNominalAngles.begin() + 3, ja.begin());
+  }
+  suite->add("incrementalFk/wrist-sweep", "poses", [&](size_t i) {
+    incremental.update(wristSweep[i % kSampleCount]);
+    auto pose = incremental.pose();
+    a3c::bench::doNotOptimize(pose);
+    return size_t{1};
+  });
+  suite->add("incrementalFk/random", "poses", [&](size_t i) {
+    incremental.update(samples[i % kSampleCount]);
+    auto pose = incremental.pose();
+    a3c::bench::doNotOptimize(pose);
+    return size_t{1};
+  });
+  a3c::JointAnglesBatch batch(kSampleCount, 6);
+  for (size_t i = 0; i < kSampleCount; ++i) {
+    for (size_t j = 0; j < 6; ++j) {
+      batch(i, j) = samples[i][j];
+    }
+  }
+  a3c::PoseBatch poses;
+  suite->add("fkBatch/random", "poses", [&](size_t) {
+    fk.fkBatch(batch, poses);
+    a3c::bench::doNotOptimize(poses);
+    return kSampleCount;
+  });
+  addFloatForwardKinematicsCases(suite, samples, batch);
+}
+
+void addJacobianCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  const auto samples = randomJointAngles(rng, kSampleCount);
+  a3c::InverseKinematics ik(kNominalAngles);
+  suite->add("getJacobian/random", "jacobians", [&](size_t i) {
+    auto jacobian = ik.getJacobian(samples[i % kSampleCount]);
+    a3c::bench::doNotOptimize(jacobian);
+    return size_t{1};
+  });
+  const a3c::ForwardKinematics fk;
+  a3c::Jacobian jacobian;
+  suite->add("fkWithJacobian/random", "jacobians", [&](size_t i) {
+    auto pose = fk.fkWithJacobian(samples[i % kSampleCount], jacobian);
+    a3c::bench::doNotOptimize(pose);
+    a3c::bench::doNotOptimize(jacobian);
+    return size_t{1};
+  });
+  const a3c::A3CChain chain;
+  suite->add("chainFkWithJacobian/random", "jacobians", [&](size_t i) {
+    auto pose = chain.fkWithJacobian(samples[i % kSampleCount], jacobian);
+    a3c::bench::doNotOptimize(pose);
+    a3c::bench::doNotOptimize(jacobian);
+    return size_t{1};
+  });
+  const auto samplesF = toFloat(samples);
+  a3c::JacobianF jacobianF;
+  const std::string name = "fkWithJacobian/random-float";
+  suite->add(name, "jacobians", [&](size_t i) {
+    auto pose = fk.fkWithJacobian(samplesF[i % kSampleCount], jacobianF);
+    a3c::bench::doNotOptimize(pose);
+    a3c::bench::doNotOptimize(jacobianF);
+    return size_t{1};
+  });
+  if (!suite->selects(name)) {
+    return;
+  }
+  double worstJacobian = 0;
+  for (size_t i = 0; i < kSampleCount; ++i) {
+    fk.fkWithJacobian(samples[i], jacobian);
+    fk.fkWithJacobian(samplesF[i], jacobianF);
+    worstJacobian =
+        std::max(worstJacobian,
+                 (jacobianF.cast<double>() - jacobian).cwiseAbs().maxCoeff());
+  }
+  suite->setMaxError(name, worstJacobian);
+}
+
+void addAnalyticalIKCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  const auto samples = randomJointAngles(rng, kSampleCount);
+  a3c::ForwardKinematics fk;
+  PoseVector poses;
+  for (const auto &ja : samples) {
+    poses.push_back(fk.fk(ja));
+  }
+  const a3c::AnalyticalIK analyticalIK(fk);
+  a3c::IKSolutions solutions;
+  suite->add("analyticalIK/solve", "poses", [&](size_t i) {
+    analyticalIK.solve(poses[i % kSampleCount], solutions);
+    a3c::bench::doNotOptimize(solutions);
+    return size_t{1};
+  });
+}
+
+/**
+ * @brief Nearest seed queries on a default sized index in the temp directory
+ * @note The index is only built when the case is selected, the targets are
+ * drawn regardless so later cases see the same samples under any filter
+ */
+void addSeedIndexCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  const a3c::ForwardKinematics fk;
+  PoseVector targets;
+  for (const auto &ja : randomJointAngles(rng, kSampleCount)) {
+    targets.push_back(fk.fk(ja));
+  }
+  const std::string name = "seedIndex/nearest";
+  if (!suite->selects(name)) {
+    return;
+  }
+  const std::string path = std::string(P_tmpdir) + "/a3c-bench-seeds.bin";
+  a3c::SeedIndex index;
+  if (!a3c::SeedIndex::build(path, fk) || !index.open(path, fk)) {
+    std::cerr << "could not build " << path << std::endl;
+    return;
+  }
+  JointAngles seed;
+  suite->add(name, "queries", [&](size_t i) {
+    index.nearestSeed(targets[i % kSampleCount], seed);
+    a3c::bench::doNotOptimize(seed);
+    return size_t{1};
+  });
+  index.close();
+  std::remove(path.c_str());
+}
+
+/**
+ * @brief Self-collision of single configurations and of whole linearIK
+ * trajectories, the trajectory case reports the waypoints checked before the
+ * early exit
+ */
+void addSelfCollisionCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  const auto samples = randomJointAngles(rng, kSampleCount);
+  const a3c::SelfCollision checker;
+  suite->add("selfCollision/clearance", "configs", [&](size_t i) {
+    auto clearance = checker.clearance(samples[i % kSampleCount]);
+    a3c::bench::doNotOptimize(clearance);
+    return size_t{1};
+  });
+  const auto move = randomMoves(rng, 1, 0.2).front();
+  const a3c::InverseKinematics ik(move.seed);
+  const auto trajectory = ik.linearIK(move.poses[0], move.poses[1]);
+  suite->add("selfCollision/trajectory", "waypoints", [&](size_t) {
+    return std::min(trajectory.size(),
+                    checker.firstCollision(trajectory) + 1);
+  });
+}
+
+/**
+ * @brief Spline compression of a 200 mm linearIK trajectory
+ */
+void addCompressionCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  const auto move = randomMoves(rng, 1, 0.2).front();
+  const a3c::InverseKinematics ik(move.seed);
+  const auto trajectory = ik.linearIK(move.poses[0], move.poses[1]);
+  const a3c::TrajectoryCompressor compressor;
+  const auto compressed = compressor.compress(trajectory);
+  suite->add("compress/200mm", "waypoints", [&](size_t) {
+    auto result = compressor.compress(trajectory);
+    a3c::bench::doNotOptimize(result);
+    return trajectory.size();
+  });
+  suite->add("compress/resample-1ms", "waypoints", [&](size_t) {
+    return compressed.resample(0.001).size();
+  });
+}
+
+/**
+ * @brief Writing and replaying a library of 64 linearIK trajectories
+ */
+void addTrajectoryFileCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  constexpr size_t kMoveCount = 64;
+  const a3c::ForwardKinematics fk;
+  std::vector<std::vector<JointAngles>> library;
+  size_t totalWaypoints = 0;
+  for (const auto &move : randomMoves(rng, kMoveCount, 0.05)) {
+    const a3c::InverseKinematics ik(move.seed);
+    library.push_back(ik.linearIK(move.poses[0], move.poses[1]));
+    totalWaypoints += library.back().size();
+  }
+  const std::string path =
+      std::string(P_tmpdir) + "/a3c-bench-trajectories.bin";
+  auto writeLibrary = [&] {
+    a3c::TrajectoryWriter writer;
+    writer.open(path, fk);
+    for (const auto &trajectory : library) {
+      writer.writeSegment(trajectory);
+    }
+    return writer.close();
+  };
+  if (!suite->selects("trajectoryFile/write") &&
+      !suite->selects("trajectoryFile/replay")) {
+    return;
+  }
+  // Replay must find the file even when the write case is filtered out
+  if (!writeLibrary()) {
+    std::cerr << "could not write " << path << std::endl;
+    return;
+  }
+  suite->add("trajectoryFile/write", "waypoints", [&](size_t) {
+    writeLibrary();
+    return totalWaypoints;
+  });
+  suite->add("trajectoryFile/replay", "waypoints", [&](size_t) {
+    a3c::TrajectoryReader reader;
+    double checksum = 0;
+    if (reader.open(path, fk)) {
+      for (const auto &waypoint : reader.all()) {
+        checksum += waypoint[0];
+      }
+    }
+    a3c::bench::doNotOptimize(checksum);
+    return reader.numWaypoints();
+  });
+  std::remove(path.c_str());
+}
+
+/**
+ * @brief Cost of one scoped probe plus one counter, zero unless the build has
+ * WANT_INSTRUMENTATION
+ */
+void addInstrumentationCases(a3c::bench::Suite *suite) {
+  suite->add("instrumentation/probe", "probes", [](size_t i) {
+    A3C_PROBE(kFk);
+    A3C_COUNT(kSteps, 1);
+    a3c::bench::doNotOptimize(i);
+    return size_t{1};
+  });
+}
+
+/**
+ * @brief linearIK over moves of several lengths with the given options
+ */
+void addLinearIKMoves(a3c::bench::Suite *suite, std::mt19937 *rng,
+                      const std::string &prefix,
+                      const a3c::IKOptions &options) {
+  constexpr size_t kMoveCount = 16;
+  for (double length : {0.01, 0.05, 0.2}) {
+    const auto moves = randomMoves(rng, kMoveCount, length);
+    suite->add(prefix + "/" +
+                   std::to_string(static_cast<int>(length * 1000)) + "mm",
+               "waypoints", [&](size_t i) {
+                 const auto &move = moves[i % kMoveCount];
+                 a3c::InverseKinematics ik(move.seed, options);
+                 return ik.linearIK(move.poses[0], move.poses[1]).size();
+               });
+  }
+}
+
+void addLinearIKCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  constexpr size_t kMoveCount = 16;
+  const std::vector<std::pair<std::string, a3c::IKSolver>> backends = {
+      {"dls", a3c::IKSolver::kDampedLeastSquares},
+      {"cod", a3c::IKSolver::kCompleteOrthogonal}};
+  for (const auto &backend : backends) {
+    a3c::IKOptions options;
+    options.solver = backend.second;
+    const auto moves = randomMoves(rng, kMoveCount, 0.001);
+    a3c::IKWorkspace workspace;
+    a3c::JointAngles nextAngles;
+    suite->add("step/" + backend.first + "/1mm", "steps", [&](size_t i) {
+      const auto &move = moves[i % kMoveCount];
+      const a3c::InverseKinematics ik(move.seed, options);
+      ik.step(move.seed, move.poses[1], workspace, nextAngles);
+      a3c::bench::doNotOptimize(nextAngles);
+      return size_t{1};
+    });
+  }
+  for (const auto &backend : backends) {
+    a3c::IKOptions options;
+    options.solver = backend.second;
+    addLinearIKMoves(suite, rng, "linearIK/" + backend.first, options);
+  }
+  a3c::IKOptions adaptive;
+  adaptive.integration = a3c::IKIntegration::kAdaptive;
+  addLinearIKMoves(suite, rng, "linearIK/dls-adaptive", adaptive);
+
+  // Full pose moves, position and orientation tracked in the same pass
+  const auto reorienting = randomMoves(rng, kMoveCount, 0.05, M_PI / 6);
+  for (const auto &integration :
+       {std::make_pair(std::string("dls"), a3c::IKIntegration::kFixedStep),
+        std::make_pair(std::string("dls-adaptive"),
+                       a3c::IKIntegration::kAdaptive)}) {
+    a3c::IKOptions options;
+    options.integration = integration.second;
+    suite->add("linearIK/" + integration.first + "/50mm-30deg", "waypoints",
+               [&](size_t i) {
+                 const auto &move = reorienting[i % kMoveCount];
+                 a3c::InverseKinematics ik(move.seed, options);
+                 return ik.linearIK(move.poses[0], move.poses[1]).size();
+               });
+  }
+
+  const auto moves = randomMoves(rng, kMoveCount, 0.2);
+  suite->add("linearTrajectory/first-waypoint/200mm", "waypoints",
+             [&](size_t i) {
+               const auto &move = moves[i % kMoveCount];
+               const a3c::InverseKinematics ik(move.seed);
+               auto generator = ik.linearTrajectory(move.poses[0],
+                                                    move.poses[1]);
+               a3c::JointAngles waypoint;
+               return static_cast<size_t>(generator.next(waypoint));
+             });
+}
+
+/**
+ * @brief BatchPlanner throughput for 1, 2, 4, ... workers up to the number of
+ * hardware threads, the scaling curve of the batch API
+ */
+void addBatchPlannerCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  constexpr size_t kJobCount = 64;
+  const auto moves = randomMoves(rng, kJobCount, 0.05);
+  a3c::PlanJobs jobs;
+  for (const auto &move : moves) {
+    jobs.push_back({move.seed, move.poses[0], move.poses[1]});
+  }
+  const size_t hardwareThreads =
+      std::max(1u, std::thread::hardware_concurrency());
+  std::vector<size_t> threadCounts;
+  for (size_t threads = 1; threads < hardwareThreads; threads *= 2) {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(hardwareThreads);
+  for (size_t threads : threadCounts) {
+    a3c::BatchPlanner planner(a3c::IKOptions(), threads);
+    suite->add("batchPlanner/50mm/threads:" + std::to_string(threads), "jobs",
+               [&](size_t) {
+                 auto results = planner.plan(jobs);
+                 a3c::bench::doNotOptimize(results);
+                 return kJobCount;
+               });
+  }
+}
+
+/**
+ * @brief One 50 mm move at a time through the planning service, in process
+ * and over its Unix domain socket, to show the front end overhead on top of
+ * linearIK/dls/50mm
+ */
+void addPlanningServiceCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  constexpr size_t kMoveCount = 16;
+  const auto moves = randomMoves(rng, kMoveCount, 0.05);
+  std::vector<a3c::PlanJob> jobs;
+  for (const auto &move : moves) {
+    jobs.push_back({move.seed, move.poses[0], move.poses[1]});
+  }
+  a3c::PlanningServiceOptions options;
+  options.numThreads = 1;
+  a3c::PlanningService service(options);
+  suite->add("planningService/50mm", "jobs", [&](size_t i) {
+    a3c::PlanTicket ticket;
+    service.submit(jobs[i % kMoveCount], a3c::PlanPriority::kNormal, ticket);
+    auto result = ticket.result.get();
+    a3c::bench::doNotOptimize(result);
+    return size_t{1};
+  });
+  a3c::PlanningServer server(service);
+  a3c::PlanningClient client;
+  const std::string path = std::string(P_tmpdir) + "/a3c-bench-planner.sock";
+  if (!server.listen(path) || !client.connect(path)) {
+    return;
+  }
+  suite->add("planningSocket/50mm", "jobs", [&](size_t i) {
+    uint64_t id = 0;
+    a3c::PlanResult result;
+    client.send(i, jobs[i % kMoveCount]);
+    client.receive(id, result);
+    a3c::bench::doNotOptimize(result);
+    return size_t{1};
+  });
+}
+
+/**
+ * @brief Joint space planning around a 0.1 m sphere at the nominal end
+ * effector position, between configurations whose straight path is blocked.
+ * roadmap/build reports roadmap nodes, the other cases queries.
+ */
+void addSamplingPlannerCases(a3c::bench::Suite *suite, std::mt19937 *rng) {
+  constexpr size_t kQueryCount = 16;
+  constexpr size_t kRoadmapNodes = 1000;
+  const a3c::ForwardKinematics fk;
+  const a3c::SelfCollision selfCollision(fk);
+  const a3c::IncrementalForwardKinematics prototype(fk);
+  const Eigen::Vector3d center = fk.fk(kNominalAngles).position;
+  const a3c::StateValidator validator = [&](const JointAngles &ja) {
+    if (selfCollision.inCollision(ja)) {
+      return false;
+    }
+    auto frames = prototype;
+    frames.update(ja);
+    for (size_t i = 0; i < a3c::IncrementalForwardKinematics::mNumLinks; ++i) {
+      const Eigen::Vector3d &p = frames.linkFrame(i).origin;
+      const Eigen::Vector3d segment = frames.linkFrame(i + 1).origin - p;
+      double t = 0.0;
+      if (segment.squaredNorm() > 0) {
+        t = std::min(1.0, std::max(0.0, (center - p).dot(segment) /
+                                            segment.squaredNorm()));
+      }
+      if ((p + t * segment - center).norm() < 0.14) {
+        return false;
+      }
+    }
+    return true;
+  };
+  a3c::SamplingPlanner planner(validator);
+  std::uniform_real_distribution<double> perturbation(-0.2, 0.2);
+  std::vector<std::pair<JointAngles, JointAngles>> queries;
+  while (queries.size() < kQueryCount) {
+    auto start = kNominalAngles;
+    auto goal = kNominalAngles;
+    for (size_t j = 0; j < start.size(); ++j) {
+      start[j] += perturbation(*rng);
+      goal[j] += perturbation(*rng);
+    }
+    start[0] -= 1.2;
+    goal[0] += 1.2;
+    if (validator(start) && validator(goal) &&
+        !planner.motionValid(start, goal)) {
+      queries.emplace_back(start, goal);
+    }
+  }
+  std::vector<JointAngles> path;
+  suite->add("rrtConnect/sphere", "queries", [&](size_t i) {
+    const auto &query = queries[i % kQueryCount];
+    planner.rrtConnect(query.first, query.second, path);
+    a3c::bench::doNotOptimize(path);
+    return size_t{1};
+  });
+  a3c::Roadmap roadmap;
+  suite->add("roadmap/build-1000", "nodes", [&](size_t) {
+    planner.buildRoadmap(kRoadmapNodes, roadmap);
+    a3c::bench::doNotOptimize(roadmap);
+    return kRoadmapNodes;
+  });
+  // The query cases need a roadmap even when the build case is filtered out
+  if (roadmap.numNodes() == 0 && (suite->selects("roadmap/kNearest-10") ||
+                                  suite->selects("roadmap/query"))) {
+    planner.buildRoadmap(kRoadmapNodes, roadmap);
+  }
+  const auto samples = randomJointAngles(rng, kSampleCount);
+  std::vector<size_t> nearest;
+  suite->add("roadmap/kNearest-10", "queries", [&](size_t i) {
+    roadmap.nodes.kNearest(samples[i % kSampleCount], 10, nearest);
+    a3c::bench::doNotOptimize(nearest);
+    return size_t{1};
+  });
+  suite->add("roadmap/query", "queries", [&](size_t i) {
+    const auto &query = queries[i % kQueryCount];
+    planner.query(roadmap, query.first, query.second, path);
+    a3c::bench::doNotOptimize(path);
+    return size_t{1};
+  });
+}
+
+/**
+ * @brief Retiming of successful 200 mm linearIK moves under the default
+ * joint limits, to compare with linearIK/dls/200mm, followed by the mean
+ * retimed duration against linearIK's fixed 1 s
+ */
+void addTimeParameterizationCases(a3c::bench::Suite *suite,
+                                  std::mt19937 *rng) {
+  constexpr size_t kMoveCount = 16;
+  const a3c::ForwardKinematics fk;
+  std::vector<std::vector<JointAngles>> paths;
+  // Only moves linearIK completes, a failed plan is never sent to retiming
+  while (paths.size() < kMoveCount) {
+    const auto move = randomMoves(rng, 1, 0.2).front();
+    auto path = a3c::InverseKinematics(move.seed)
+                    .linearIK(move.poses[0], move.poses[1]);
+    if ((fk.fk(path.back()).position - move.poses[1].position).norm() <
+        1E-4) {
+      paths.push_back(std::move(path));
+    }
+  }
+  const a3c::KinematicLimits limits;
+  a3c::TimedTrajectory timed;
+  suite->add("timeParameterize/200mm", "waypoints", [&](size_t i) {
+    const auto &path = paths[i % kMoveCount];
+    a3c::timeParameterize(path, limits, timed);
+    return path.size();
+  });
+  suite->add("timeParameterize/resample-1ms", "samples", [&](size_t) {
+    return timed.resample(1E-3).size();
+  });
+  if (suite->results().empty() ||
+      suite->results().back().name != "timeParameterize/resample-1ms") {
+    return;
+  }
+  // Median, a move through a wrist flip sweeps far more joint travel and
+  // takes tens of seconds
+  std::vector<double> durations;
+  for (const auto &path : paths) {
+    a3c::timeParameterize(path, limits, timed);
+    durations.push_back(timed.duration());
+  }
+  std::nth_element(durations.begin(), durations.begin() + kMoveCount / 2,
+                   durations.end());
+  std::cout << std::defaultfloat << std::setprecision(3)
+            << "timeParameterize/200mm median duration "
+            << durations[kMoveCount / 2] << " s (linearIK: 1 s)" << std::endl;
+}
+
+void printUsage(const char *argv0) {
+  std::cerr << "usage: " << argv0
+            << " [--filter <substr>] [--min-time <secs>] [--json <file>]"
+               " [--baseline <file>] [--threshold <fraction>]"
+            << std::endl;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  a3c::bench::Options options;
+  std::string jsonPath;
+  std::string baselinePath;
+  double threshold = 0.1;
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--filter") && hasValue) {
+      options.filter = argv[++i];
+    } else if (!std::strcmp(argv[i], "--min-time") && hasValue) {
+      options.minTimeSecs = std::atof(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--json") && hasValue) {
+      jsonPath = argv[++i];
+    } else if (!std::strcmp(argv[i], "--baseline") && hasValue) {
+      baselinePath = argv[++i];
+    } else if (!std::strcmp(argv[i], "--threshold") && hasValue) {
+      threshold = std::atof(argv[++i]);
+    } else {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Fixed seed so every run measures the same configurations
+  std::mt19937 rng(808);
+  a3c::bench::Suite suite(options);
+  addForwardKinematicsCases(&suite, &rng);
+  addJacobianCases(&suite, &rng);
+  addAnalyticalIKCases(&suite, &rng);
+  addSeedIndexCases(&suite, &rng);
+  addSelfCollisionCases(&suite, &rng);
+  addCompressionCases(&suite, &rng);
+  addTrajectoryFileCases(&suite, &rng);
+  addInstrumentationCases(&suite);
+  addLinearIKCases(&suite, &rng);
+  addBatchPlannerCases(&suite, &rng);
+  addPlanningServiceCases(&suite, &rng);
+  addSamplingPlannerCases(&suite, &rng);
+  addTimeParameterizationCases(&suite, &rng);
+
+  if (!jsonPath.empty() && !a3c::bench::writeJson(jsonPath, suite.results())) {
+    std::cerr << "could not write " << jsonPath << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!baselinePath.empty()) {
+    int regressions = a3c::bench::compareWithBaseline(
+        std::cout, baselinePath, suite.results(), threshold);
+    if (regressions < 0) {
+      std::cerr << "could not read baseline " << baselinePath << std::endl;
+      return EXIT_FAILURE;
+    }
+    return regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
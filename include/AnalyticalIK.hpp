@@ -0,0 +1,105 @@
+/**
+ * @file AnalyticalIK.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Seed free inverse kinematics returning every joint solution of a pose
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef AnalyticalIK_HPP
+#define AnalyticalIK_HPP
+
+#include <array>
+#include <cstddef>
+
+#include "ForwardKinematics.hpp"
+
+namespace a3c {
+/**
+ * @brief Joint solutions of one pose, fixed capacity so solving never
+ * allocates
+ */
+struct IKSolutions {
+  constexpr static const size_t mMaxSolutions = 16;
+  std::array<JointAngles, mMaxSolutions> solutions;
+  size_t count = 0;
+};
+
+/**
+ * @brief Analytical IK for the A3C geometry
+ * @note The A3C wrist is not spherical: axes 4/5 meet at the wrist point W and
+ * axes 5/6 meet d5 further along axis 5. Given the target, the 5/6 crossing C
+ * and axis 6 are known, so W lies on a circle of radius d5 around C in the
+ * plane normal to axis 6. Every point of that circle gives joints 1-3 in
+ * closed form (two shoulder and two elbow branches), and the only condition
+ * left is that the forearm (axis 4) is normal to axis 5. The circle is cut
+ * into arcs where the arm reaches the wrist point, split further where the
+ * wrist passes close to the joint 1 axis. On each arc that scalar equation
+ * is bracketed on an adaptively refined grid, then joints 4-6 follow in closed
+ * form as ZYZ angles. Work per query is bounded. Solutions are checked with
+ * FK before they are returned.
+ */
+class AnalyticalIK {
+ public:
+  // @brief Grid cells over the circle used to bracket roots
+  constexpr static const size_t mNumSamples = 64;
+  constexpr static const size_t mNumArmBranches = 4;
+  // @brief Most arcs the circle is cut into
+  constexpr static const size_t mMaxArcs = 8;
+  using Residuals = std::array<double, mNumArmBranches>;
+
+  // @brief Read the link geometry from fk
+  explicit AnalyticalIK(const ForwardKinematics &fk) noexcept;
+  // @brief Every joint solution reaching targetPose
+  void solve(const Pose &targetPose, IKSolutions &result) const noexcept;
+  // @brief The solution of targetPose closest to reference, false if there is
+  // none. Angles are unwrapped by whole turns toward reference.
+  bool solveClosest(const Pose &targetPose, const JointAngles &reference,
+                    JointAngles &solution) const noexcept;
+
+ private:
+  /**
+   * @brief Arc [begin, begin + length] of the circle angle
+   */
+  struct Arc {
+    double begin;
+    double length;
+    // @brief The whole circle, sampled periodically
+    bool whole;
+    // @brief Circle angle at grid coordinate u in [0, 1], see solveArc()
+    double angle(double u) const noexcept;
+  };
+  // @brief Arcs on which the arm reaches the wrist point, returns how many
+  size_t reachableArcs(const Eigen::Vector3d &crossing, const Matrix3d &R,
+                       std::array<Arc, mMaxArcs> &arcs) const noexcept;
+  // @brief Roots of every arm branch on one arc
+  void solveArc(const Pose &targetPose, const Eigen::Vector3d &crossing,
+                const Matrix3d &R, const Arc &arc,
+                IKSolutions &result) const noexcept;
+  /**
+   * @brief Joints 1-3 placing the wrist point, see solve()
+   * @return false if the wrist point is out of reach for this branch
+   */
+  bool solveArm(const Eigen::Vector3d &wrist, size_t branch, double &theta1,
+                double &theta2, double &theta3) const noexcept;
+  // @brief Forearm . axis 5 of every arm branch for one circle angle, NaN
+  // where the wrist point is out of reach
+  Residuals residuals(const Eigen::Vector3d &crossing, const Matrix3d &R,
+                      double cosPhi, double sinPhi) const noexcept;
+  double residual(const Eigen::Vector3d &crossing, const Matrix3d &R,
+                  double phi, size_t branch) const noexcept;
+  // @brief Complete a root phi to full joint angles and verify them
+  void completeSolution(const Pose &targetPose, const Eigen::Vector3d &crossing,
+                        double phi, size_t branch,
+                        IKSolutions &result) const noexcept;
+
+  ForwardKinematics forwardKinematics;
+  // @brief Link geometry, metres
+  double d1, lateralOffset, a2, d4, d5, d6;
+};
+}  // namespace a3c
+
+#endif
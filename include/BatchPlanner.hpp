@@ -0,0 +1,99 @@
+/**
+ * @file BatchPlanner.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Plans many linearIK moves in parallel
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef BatchPlanner_HPP
+#define BatchPlanner_HPP
+
+#include <atomic>
+#include <vector>
+
+#include "InverseKinematics.hpp"
+#include "ThreadPool.hpp"
+
+namespace a3c {
+/**
+ * @brief One linear move to plan
+ */
+struct PlanJob {
+  // @brief Joint angles the move starts from, the pose of currentPose
+  JointAngles startAngles;
+  Pose currentPose;
+  Pose targetPose;
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+using PlanJobs = std::vector<PlanJob, Eigen::aligned_allocator<PlanJob>>;
+
+/**
+ * @brief Outcome of a planned move
+ */
+enum class PlanStatus {
+  kSuccess,
+  // @brief The last waypoint is further than goalTolerance from the target
+  // position or further than IKOptions::angularTolerance from its orientation
+  kGoalNotReached,
+  // @brief The solve diverged, a waypoint holds NaN or infinity
+  kNonFinite,
+  // @brief The solve threw, e.g. out of memory for the trajectory
+  kFailed,
+  // @brief Cancelled before or between IK steps, the trajectory is partial
+  kCancelled,
+  // @brief Not accepted, the request queue was full or shutting down, or a
+  // socket client reused the id of a request still in flight
+  kRejected,
+};
+
+/**
+ * @brief Trajectory and status of one PlanJob
+ */
+struct PlanResult {
+  PlanStatus status = PlanStatus::kFailed;
+  std::vector<JointAngles> trajectory;
+  // @brief Distance from the last waypoint to the target position, metres
+  double goalError = 0;
+  // @brief Wall time spent planning this job on its worker
+  double solveSecs = 0;
+};
+
+/**
+ * @brief Run linearIK for job and classify the outcome, never throws
+ * @note With a cancelled flag the move is integrated step by step and
+ * abandoned as soon as the flag reads true, otherwise linearIK is called.
+ * fk verifies the last waypoint.
+ */
+PlanResult planJob(const PlanJob &job, const IKOptions &options,
+                   double goalTolerance, const ForwardKinematics &fk,
+                   const std::atomic<bool> *cancelled = nullptr) noexcept;
+
+/**
+ * @brief Runs InverseKinematics::linearIK for many jobs on a ThreadPool
+ * @note Jobs are independent, each one builds its own InverseKinematics, so
+ * throughput scales with the number of workers. Results come back in job
+ * order whatever order the workers finished in.
+ */
+class BatchPlanner {
+ public:
+  // @brief numThreads 0 means one worker per hardware thread
+  explicit BatchPlanner(const IKOptions &inOptions = IKOptions(),
+                        size_t numThreads = 0, double inGoalTolerance = 1E-3);
+  // @brief Plan every job, results[i] belongs to jobs[i]
+  std::vector<PlanResult> plan(const PlanJobs &jobs);
+  size_t numThreads() const noexcept { return pool.size(); }
+
+ private:
+  IKOptions options;
+  double goalTolerance;
+  // @brief Verifies the last waypoint of each trajectory
+  ForwardKinematics forwardKinematics;
+  ThreadPool pool;
+};
+}  // namespace a3c
+
+#endif
@@ -1,7 +1,7 @@
 /**
  * @file ForwardKinematics.hpp
  * @author Jerry Pittman, Jr. (jpittma1@umd.edu)
- * @brief ForwardKinematics, Pose Struct, and DHParams Structt
+ * @brief ForwardKinematics and Pose Struct
  * @version 0.1
  * @date 2023-10-21
  *
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <eigen3/Eigen/Dense>
 #include <iostream>
 #include <iterator>
@@ -21,70 +22,135 @@
 #include <string>
 #include <vector>
 
+#include "RobotDescription.hpp"
+
 using namespace Eigen;
 
 //@brief Namespace a3c
 namespace a3c {
-using JointAngles = std::array<double, 6>;
+// @brief Joint angles in radians, Scalar is double or float
+template <typename Scalar>
+using BasicJointAngles = std::array<Scalar, 6>;
+using JointAngles = BasicJointAngles<double>;
+using JointAnglesF = BasicJointAngles<float>;
+// @brief Geometric Jacobian, rows are linear velocity x,y,z then angular x,y,z
+template <typename Scalar>
+using BasicJacobian = Eigen::Matrix<Scalar, 6, 6>;
+using Jacobian = BasicJacobian<double>;
+using JacobianF = BasicJacobian<float>;
 /**
  @brief Pose struct
  @note Contains position and orientation , which are extracted from a 4x4
- Transformations Matrix
+ Transformations Matrix. Pose is the double precision pose used by the
+ solvers, PoseF the single precision one of float kinematics.
 */
-struct Pose {
+template <typename Scalar>
+struct BasicPose {
   /**
   @brief Construct a new Pose object
   @param T HomogenousTransformationMatrix
   */
-  explicit Pose(const Matrix4d &T) {
+  explicit BasicPose(const Eigen::Matrix<Scalar, 4, 4> &T) {
     this->position = {T(0, 3), T(1, 3), T(2, 3)};
-    this->orientation = Eigen::Quaterniond(T.topLeftCorner<3, 3>());
+    this->orientation =
+        Eigen::Quaternion<Scalar>(T.template topLeftCorner<3, 3>());
   }
-  Eigen::Vector3d position;
-  Eigen::Quaterniond orientation;
-  friend std::ostream &operator<<(std::ostream &out, const Pose &pose);
+  Eigen::Matrix<Scalar, 3, 1> position;
+  Eigen::Quaternion<Scalar> orientation;
 };
+using Pose = BasicPose<double>;
+using PoseF = BasicPose<float>;
+std::ostream &operator<<(std::ostream &out, const Pose &pose);
 /**
-  @brief DHParams Struct captures the DH parameters of the robot
-  @note Contains DH parameters of the A3C 6DoF serial manipulator
+ @brief Joint angles of many configurations, in structure-of-arrays layout
+ @note Column i holds joint i of every sample, Eigen stores columns
+ contiguously so each joint is one dense array
 */
-struct DHParams {
-  float d1, d2, d3, d4, d5, d6, a2;  // @note They are expected to be in metres
-  /**
-   @brief Assign DH params of robot
-  */
-  DHParams(float d1, float d2, float d3, float d4, float d5, float d6,
-           float a2);
+template <typename Scalar>
+using BasicJointAnglesBatch = Eigen::Matrix<Scalar, Eigen::Dynamic, 6>;
+using JointAnglesBatch = BasicJointAnglesBatch<double>;
+using JointAnglesBatchF = BasicJointAnglesBatch<float>;
+/**
+ @brief Poses of many configurations, in structure-of-arrays layout
+*/
+template <typename Scalar>
+struct BasicPoseBatch {
+  // @brief x, y, z of every sample
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 3> positions;
+  // @brief Quaternion x, y, z, w of every sample
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 4> orientations;
 };
+using PoseBatch = BasicPoseBatch<double>;
+using PoseBatchF = BasicPoseBatch<float>;
 
 /**
  * @brief FK Class
  * @note Computes the Forward Kinematics of the robot, and outputs the Pose of
- * the end effector given joint angles
+ * the end effector given joint angles. The DH table is fixed at construction
+ * and every method is const, so one instance can be shared by any number of
+ * threads without locking. The table is read at runtime, KinematicChain is the
+ * compile time specialized counterpart. fk, fkWithJacobian and fkBatch have
+ * single precision overloads for sampling workloads; the solvers in
+ * InverseKinematics stay double precision.
  */
 class ForwardKinematics {
  public:
   constexpr static const size_t mNumDHRows = 6;
   constexpr static const size_t mNumDHCols = 4;
+  // @brief Samples processed together by fkBatch, the float overload fits
+  // twice as many in the same registers
+  constexpr static const size_t mBatchLanes = 8;
+  constexpr static const size_t mFloatBatchLanes = 2 * mBatchLanes;
   using DHTable = Eigen::Array<double, mNumDHRows, mNumDHCols>;
-
- private:
+  // @brief Columns of DHTable (modified DH)
   constexpr static const size_t alphaIndex = 0;
   constexpr static const size_t aIndex = 1;
   constexpr static const size_t dIndex = 2;
   constexpr static const size_t thetaIndex = 3;
-  DHTable dhTable;
-  /**
-   * Declaring these for the A3C here, later can be read from a file in the
-   * constructor and set
-   */
-  const DHParams dhParams{0.1915, 0.1405, 0.1415, 0.230, 0.1635, 0.1665, 0.230};
+
+ private:
+  // @brief Immutable after construction
+  const DHTable dhTable;
 
  public:
+  // @brief Pose of the end effector, reentrant
+  Pose fk(const JointAngles &ja) const noexcept;
+  // @brief FK and geometric Jacobian from a single walk of the DH chain
+  Pose fkWithJacobian(const JointAngles &ja,
+                      Jacobian &jacobian) const noexcept;
+  // @brief Single precision fk, the DH constants are rounded to float
+  PoseF fk(const JointAnglesF &ja) const noexcept;
+  // @brief Single precision fkWithJacobian
+  PoseF fkWithJacobian(const JointAnglesF &ja,
+                       JacobianF &jacobian) const noexcept;
+  // @brief FK of every row of jointAngles, mBatchLanes samples at a time
+  void fkBatch(const JointAnglesBatch &jointAngles,
+               PoseBatch &poses) const noexcept;
+  // @brief Single precision fkBatch, mFloatBatchLanes samples at a time
+  void fkBatch(const JointAnglesBatchF &jointAngles,
+               PoseBatchF &poses) const noexcept;
+  // @brief FK of the A3C, the table of A3CDescription
+  ForwardKinematics() noexcept;
+  // @brief FK of any 6 joint arm given its modified DH table
+  explicit ForwardKinematics(const DHTable &inDHTable) noexcept;
   /**
+   * @brief DHTable of a compile time robot description, see KinematicChain
    */
-  Pose fk(const JointAngles &ja) noexcept;
-  ForwardKinematics() noexcept;
+  template <typename Description>
+  static DHTable makeDHTable() noexcept {
+    static_assert(Description::mNumJoints == mNumDHRows,
+                  "ForwardKinematics handles 6 joint arms");
+    DHTable table;
+    const auto rows = Description::dhTable();
+    for (size_t i = 0; i < mNumDHRows; ++i) {
+      table.row(i) << rows[i].alpha, rows[i].a, rows[i].d, rows[i].theta;
+    }
+    return table;
+  }
+  // @brief DH table, theta column holds the joint offsets
+  const DHTable &getDHTable() const noexcept { return dhTable; }
+  // @brief Fingerprint of the DH table, stored in files derived from it
+  uint64_t dhHash() const noexcept;
   Matrix4d getTransformationMatrix(
       const Eigen::Array<double, 1, mNumDHCols> &dhRow) const noexcept;
 };
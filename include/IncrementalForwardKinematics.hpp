@@ -0,0 +1,73 @@
+/**
+ * @file IncrementalForwardKinematics.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief FK that recomputes only the links after the first changed joint
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef IncrementalForwardKinematics_HPP
+#define IncrementalForwardKinematics_HPP
+
+#include <array>
+#include <cstddef>
+#include <eigen3/Eigen/Dense>
+
+#include "ForwardKinematics.hpp"
+
+namespace a3c {
+/**
+ * @brief Pose of one link frame in the base frame
+ */
+struct LinkFrame {
+  Eigen::Matrix3d rotation = Eigen::Matrix3d::Identity();
+  Eigen::Vector3d origin = Eigen::Vector3d::Zero();
+};
+
+/**
+ * @brief Stateful FK caching the cumulative transforms T0..T6
+ * @note update() compares the new joint angles with the cached ones and walks
+ * the chain only from the first joint that changed, so sweeping the wrist
+ * joints rebuilds three links instead of six. Every link frame stays
+ * available for collision checks. Unlike ForwardKinematics an instance holds
+ * state, use one per thread.
+ */
+class IncrementalForwardKinematics {
+ public:
+  constexpr static const size_t mNumLinks = ForwardKinematics::mNumDHRows;
+
+  // @brief Cache the link geometry of fk, the cached pose is all joints at 0
+  explicit IncrementalForwardKinematics(
+      const ForwardKinematics &fk = ForwardKinematics()) noexcept;
+  /**
+   * @brief Move to jointAngles
+   * @return size_t First joint whose link was recomputed, mNumLinks if no
+   * joint changed
+   */
+  size_t update(const JointAngles &jointAngles) noexcept;
+  // @brief Frame of link i after update(), 0 is the base, mNumLinks the end
+  // effector
+  const LinkFrame &linkFrame(size_t i) const noexcept { return frames[i]; }
+  // @brief Pose of the end effector after update()
+  Pose pose() const noexcept;
+  // @brief Joint angles of the cached frames
+  const JointAngles &jointAngles() const noexcept { return angles; }
+
+ private:
+  // @brief frames[i + 1] from frames[i] and the angle of joint i
+  void updateLink(size_t i) noexcept;
+
+  std::array<double, mNumLinks> cosAlpha;
+  std::array<double, mNumLinks> sinAlpha;
+  std::array<double, mNumLinks> linkA;
+  std::array<double, mNumLinks> linkD;
+  std::array<double, mNumLinks> thetaOffset;
+  std::array<LinkFrame, mNumLinks + 1> frames;
+  JointAngles angles;
+};
+}  // namespace a3c
+
+#endif
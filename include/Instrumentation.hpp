@@ -0,0 +1,192 @@
+/**
+ * @file Instrumentation.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Scoped timers and counters on the FK/IK hot paths
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * @note Probes are only compiled in when A3C_INSTRUMENTATION is defined
+ * (cmake -D WANT_INSTRUMENTATION=ON). Otherwise every A3C_ macro expands to
+ * nothing, its arguments are not evaluated, and the snapshot stays zero.
+ */
+
+#ifndef Instrumentation_HPP
+#define Instrumentation_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace a3c {
+/**
+ * @brief Timed scopes, each records calls and elapsed cycles
+ */
+enum class Probe {
+  kFk,
+  kFkWithJacobian,
+  kGetJacobian,
+  // @brief Joint increment solve, LDLT or complete orthogonal decomposition
+  kVelocitySolve,
+  kLinearIK,
+  kCount,
+};
+
+/**
+ * @brief Event counters
+ */
+enum class Counter {
+  // @brief Started linearIK moves, steps / moves is the iterations per move
+  kMoves,
+  // @brief IK velocity steps, including rejected adaptive trial steps
+  kSteps,
+  // @brief Adaptive trial steps that missed cartesianTolerance
+  kRejectedSteps,
+  // @brief Adaptive steps accepted over tolerance at the minimum step length
+  kToleranceViolations,
+  // @brief Damped least squares steps below manipulabilityThreshold
+  kDampedSteps,
+  // @brief Heap allocations made by instrumented code
+  kAllocations,
+  // @brief Trajectory vectors that outgrew their reserved capacity
+  kVectorGrowth,
+  kCount,
+};
+
+/**
+ * @brief Totals of every thread at one point in time
+ */
+struct InstrumentationSnapshot {
+  static constexpr size_t mNumProbes = static_cast<size_t>(Probe::kCount);
+  static constexpr size_t mNumCounters = static_cast<size_t>(Counter::kCount);
+  // @brief Decades [1, 10), [10, 100), ... of the Jacobian condition number,
+  // the last bucket also holds singular Jacobians
+  static constexpr size_t mNumConditionBuckets = 8;
+  // @brief False when the library was built without A3C_INSTRUMENTATION
+  bool enabled = false;
+  std::array<uint64_t, mNumProbes> calls{};
+  // @brief Time stamp counter ticks spent inside each probe
+  std::array<uint64_t, mNumProbes> cycles{};
+  std::array<uint64_t, mNumCounters> counters{};
+  std::array<uint64_t, mNumConditionBuckets> conditionHistogram{};
+};
+
+namespace instrumentation {
+/**
+ * @brief Counters of one thread
+ * @note Only the owning thread writes, so an increment is a relaxed load and
+ * store without a locked instruction or cache line sharing. Blocks live as
+ * long as the process, counts of finished threads stay in the totals.
+ */
+struct ThreadCounters {
+  std::array<std::atomic<uint64_t>, InstrumentationSnapshot::mNumProbes> calls;
+  std::array<std::atomic<uint64_t>, InstrumentationSnapshot::mNumProbes>
+      cycles;
+  std::array<std::atomic<uint64_t>, InstrumentationSnapshot::mNumCounters>
+      counters;
+  std::array<std::atomic<uint64_t>,
+             InstrumentationSnapshot::mNumConditionBuckets>
+      conditionHistogram;
+};
+
+// @brief Block of the calling thread, nullptr until its first probe
+extern thread_local ThreadCounters *tlsCounters;
+// @brief Allocate and register the block of the calling thread
+ThreadCounters &registerThread();
+
+inline ThreadCounters &threadCounters() noexcept {
+  ThreadCounters *counters = tlsCounters;
+  return counters != nullptr ? *counters : registerThread();
+}
+
+inline void add(std::atomic<uint64_t> &value, uint64_t n) noexcept {
+  value.store(value.load(std::memory_order_relaxed) + n,
+              std::memory_order_relaxed);
+}
+
+inline uint64_t readCycles() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+inline void count(Counter counter, uint64_t n) noexcept {
+  add(threadCounters().counters[static_cast<size_t>(counter)], n);
+}
+
+/**
+ * @brief Add a condition number to the histogram
+ * @param condition Ratio of the largest to the smallest singular value
+ * estimate, infinity or NaN for a singular matrix
+ */
+inline void recordCondition(double condition) noexcept {
+  size_t bucket = 0;
+  // !(x < 10) also sends NaN to the last bucket
+  while (bucket + 1 < InstrumentationSnapshot::mNumConditionBuckets &&
+         !(condition < 10)) {
+    condition /= 10;
+    ++bucket;
+  }
+  add(threadCounters().conditionHistogram[bucket], 1);
+}
+
+/**
+ * @brief Times the enclosing scope
+ */
+class ScopedProbe {
+ public:
+  explicit ScopedProbe(Probe inProbe) noexcept
+      : probe(static_cast<size_t>(inProbe)), start(readCycles()) {}
+  ~ScopedProbe() {
+    ThreadCounters &counters = threadCounters();
+    add(counters.cycles[probe], readCycles() - start);
+    add(counters.calls[probe], 1);
+  }
+  ScopedProbe(const ScopedProbe &) = delete;
+  ScopedProbe &operator=(const ScopedProbe &) = delete;
+
+ private:
+  size_t probe;
+  uint64_t start;
+};
+}  // namespace instrumentation
+
+// @brief Sum of the counters of every thread that ran a probe
+InstrumentationSnapshot instrumentationSnapshot();
+// @brief Zero all counters, counts made concurrently with the reset may be
+// kept or lost
+void resetInstrumentation();
+// @brief Snapshot as one JSON object, e.g. for fleet monitoring
+std::string toJson(const InstrumentationSnapshot &snapshot);
+// @brief Name of a probe or counter as used in the JSON output
+const char *probeName(Probe probe) noexcept;
+const char *counterName(Counter counter) noexcept;
+}  // namespace a3c
+
+#define A3C_CONCAT_INNER(a, b) a##b
+#define A3C_CONCAT(a, b) A3C_CONCAT_INNER(a, b)
+
+#ifdef A3C_INSTRUMENTATION
+#define A3C_PROBE(probe)                                     \
+  ::a3c::instrumentation::ScopedProbe A3C_CONCAT(a3cProbe, \
+                                                 __LINE__)(::a3c::Probe::probe)
+#define A3C_COUNT(counter, n) \
+  ::a3c::instrumentation::count(::a3c::Counter::counter, (n))
+#define A3C_CONDITION(condition) \
+  ::a3c::instrumentation::recordCondition(condition)
+#else
+#define A3C_PROBE(probe) static_cast<void>(0)
+#define A3C_COUNT(counter, n) static_cast<void>(0)
+#define A3C_CONDITION(condition) static_cast<void>(0)
+#endif
+
+#endif
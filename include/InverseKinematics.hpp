@@ -29,26 +29,206 @@ using namespace Eigen;
 
 namespace a3c {
 using JointAngles = std::array<double, 6>;
+// @brief Cartesian twist, linear x,y,z then angular x,y,z
+using Twist = Eigen::Matrix<double, 6, 1>;
+
+/**
+ * @brief Backend turning a Cartesian twist into a joint increment
+ */
+enum class IKSolver {
+  // @brief J^T (J J^T + lambda^2 I)^-1 twist, solved with a 6x6 LDLT
+  kDampedLeastSquares,
+  // @brief Minimum norm solution from a complete orthogonal decomposition
+  kCompleteOrthogonal,
+};
+
+/**
+ * @brief How linearIK advances along the path
+ */
+enum class IKIntegration {
+  // @brief phi advances by deltaTimeSecs, one waypoint per control tick
+  kFixedStep,
+  // @brief Step length chosen so the arm stays within cartesianTolerance
+  kAdaptive,
+};
+
+/**
+ * @brief Tuning of the IK velocity step
+ */
+struct IKOptions {
+  IKSolver solver = IKSolver::kDampedLeastSquares;
+  IKIntegration integration = IKIntegration::kFixedStep;
+  // @brief Allowed deviation from the straight line path in metres,
+  // kAdaptive. Steps never shrink below deltaTimeSecs, a step that still
+  // misses is taken and counted, see TrajectoryGenerator::toleranceViolations
+  double cartesianTolerance = 1E-4;
+  // @brief Allowed deviation from the slerped orientation in radians,
+  // kAdaptive
+  double angularTolerance = 1E-3;
+  // @brief Manipulability |det J| below which damped least squares damps
+  double manipulabilityThreshold = 1E-4;
+  // @brief Damping lambda reached at zero manipulability
+  double maxDamping = 0.05;
+};
+
+/**
+ * @brief Caller owned scratch space for InverseKinematics::step
+ * @note Every buffer a step needs is fixed size Eigen storage, so a step never
+ * touches the heap. Keep one workspace per control thread and reuse it.
+ */
+struct IKWorkspace {
+  Jacobian jacobian;
+  Twist twist;
+  Twist jointDelta;
+  // @brief J J^T (+ lambda^2 I) and its factorization, damped least squares
+  Jacobian normal;
+  LDLT<Jacobian> ldlt;
+  CompleteOrthogonalDecomposition<Jacobian> solver;
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+class TrajectoryGenerator;
+
+// @brief Rotation vector taking actual onto target in the base frame, the
+// angular part of the twist that closes an orientation error
+Eigen::Vector3d orientationError(const Eigen::Quaterniond& actual,
+                                 const Eigen::Quaterniond& target) noexcept;
 
 /**
  * @brief Class IK
- *
+ * @note Double precision only. The damped least squares step solves with
+ * J J^T, whose condition number is the square of the Jacobian's, so near a
+ * singularity a float solve would lose the tolerances of IKOptions.
  */
 class InverseKinematics {
+  friend class TrajectoryGenerator;
+
  private:
   // @brief Time step for integration
   float deltaTimeSecs;
   // @brief Initial Joint Angles
   JointAngles initialJointAngles;
+  // @brief Solver backend and its tuning
+  IKOptions options;
+  // @brief Source of the per step pose feedback and Jacobian
+  ForwardKinematics forwardKinematics;
+  // @brief Solve workspace.jacobian * jointDelta = workspace.twist with the
+  // configured backend
+  void solveVelocityStep(IKWorkspace& workspace) const noexcept;
+  // @brief step() for which workspace.jacobian and actualPose already hold the
+  // FK pass of currentAngles
+  double stepFrom(const JointAngles& currentAngles, const Pose& actualPose,
+                  const Pose& targetPose, IKWorkspace& workspace,
+                  JointAngles& nextAngles) const noexcept;
 
  public:
-  explicit InverseKinematics(const JointAngles& inInitialJointAngles) noexcept;
+  explicit InverseKinematics(const JointAngles& inInitialJointAngles,
+                             const IKOptions& inOptions = IKOptions()) noexcept;
   // @brief Solve for Inverse Kinematics, given currentPose and targetPose as a
-  // Linear translation between current and targetPose
+  // Linear translation between current and targetPose, with the orientation
+  // slerped along
   std::vector<JointAngles> linearIK(const Pose& currentPose,
-                                    const Pose& targetPose);
+                                    const Pose& targetPose) const;
+  // @brief Same path as linearIK, produced one waypoint at a time on demand
+  TrajectoryGenerator linearTrajectory(const Pose& currentPose,
+                                       const Pose& targetPose) const noexcept;
+  // @brief One allocation free joint increment toward a Cartesian set-point
+  double step(const JointAngles& currentAngles, const Pose& targetPose,
+              IKWorkspace& workspace, JointAngles& nextAngles) const noexcept;
   // @brief Get jacobian matrix for a current set of robot joint angles
-  MatrixXd getJacobian(const JointAngles& jointAngles);
+  MatrixXd getJacobian(const JointAngles& jointAngles) const;
+};
+
+/**
+ * @brief Lazily computes the waypoints of a linearIK move
+ * @note Each waypoint costs one IK step (a few trial steps with
+ * IKIntegration::kAdaptive) when it is asked for, so the first waypoint is
+ * ready after one step and memory does not grow with the move length. The
+ * generator refers to the InverseKinematics that created it, which must
+ * outlive it.
+ */
+class TrajectoryGenerator {
+ public:
+  /**
+   * @brief Input iterator over the waypoints not yet produced
+   */
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = JointAngles;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const JointAngles*;
+    using reference = const JointAngles&;
+    iterator() noexcept = default;
+    explicit iterator(TrajectoryGenerator* inGenerator) noexcept
+        : generator(inGenerator) {
+      ++*this;
+    }
+    reference operator*() const noexcept { return waypoint; }
+    pointer operator->() const noexcept { return &waypoint; }
+    iterator& operator++() noexcept {
+      if (generator != nullptr && !generator->next(waypoint)) {
+        generator = nullptr;
+      }
+      return *this;
+    }
+    bool operator==(const iterator& other) const noexcept {
+      return generator == other.generator;
+    }
+    bool operator!=(const iterator& other) const noexcept {
+      return !(*this == other);
+    }
+
+   private:
+    TrajectoryGenerator* generator = nullptr;
+    JointAngles waypoint;
+  };
+
+  TrajectoryGenerator(const InverseKinematics& inIK, const Pose& currentPose,
+                      const Pose& targetPose) noexcept;
+  // @brief Compute the next waypoint, false once the target has been reached
+  bool next(JointAngles& waypoint) noexcept;
+  // @brief Compute up to capacity waypoints into a caller owned buffer, e.g.
+  // the free region of a ring buffer. Returns how many were written.
+  size_t fill(JointAngles* waypoints, size_t capacity) noexcept;
+  // @brief True once the last waypoint has been produced
+  bool done() const noexcept { return phi >= 1; }
+  // @brief Number of waypoints a full move is expected to produce, exact for
+  // IKIntegration::kFixedStep
+  size_t sizeHint() const noexcept;
+  // @brief Waypoints so far that exceed cartesianTolerance or
+  // angularTolerance because the step could not shrink further, kAdaptive
+  size_t toleranceViolations() const noexcept { return violations; }
+  iterator begin() noexcept { return iterator(this); }
+  iterator end() noexcept { return iterator(); }
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+ private:
+  // @brief Path point at phi of the straight line move
+  Eigen::Vector3d pathPoint(double phi) const noexcept;
+  // @brief Orientation at phi, slerp from the current to the target pose
+  Eigen::Quaterniond pathOrientation(double phi) const noexcept;
+  bool nextFixedStep(JointAngles& waypoint) noexcept;
+  bool nextAdaptive(JointAngles& waypoint) noexcept;
+
+  const InverseKinematics& ik;
+  Eigen::Vector3d startPosition;
+  Eigen::Vector3d endPosition;
+  Eigen::Quaterniond startOrientation;
+  Eigen::Quaterniond endOrientation;
+  // @brief Set-point of the step being taken
+  Pose setPoint;
+  // @brief Measured pose of currentAngles, workspace.jacobian its Jacobian
+  Pose actualPose;
+  JointAngles currentAngles;
+  IKWorkspace workspace;
+  // @brief FK pass of a trial step, kept if the step is accepted
+  Jacobian candidateJacobian;
+  // @brief Path parameter reached so far, 0 at the start, 1 at the target
+  double phi;
+  // @brief Next trial step length in phi, kAdaptive
+  double h;
+  size_t violations = 0;
 };
 }  // namespace a3c
 
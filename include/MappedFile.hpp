@@ -0,0 +1,42 @@
+/**
+ * @file MappedFile.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Read only memory mapping of a whole file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MappedFile_HPP
+#define MappedFile_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace a3c {
+/**
+ * @brief Owns a read only mmap of a file, unmapped on close or destruction
+ */
+class MappedFile {
+ public:
+  MappedFile() noexcept = default;
+  ~MappedFile() { close(); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // @brief Map path, false if it cannot be opened or is empty
+  bool open(const std::string &path) noexcept;
+  void close() noexcept;
+  bool isOpen() const noexcept { return mapping != nullptr; }
+  const void *data() const noexcept { return mapping; }
+  size_t size() const noexcept { return mappingSize; }
+
+ private:
+  void *mapping = nullptr;
+  size_t mappingSize = 0;
+};
+}  // namespace a3c
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file PlanningService.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Asynchronous linearIK planning with a bounded priority queue
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef PlanningService_HPP
+#define PlanningService_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BatchPlanner.hpp"
+
+namespace a3c {
+/**
+ * @brief Queue order of a request, urgent requests are taken first
+ */
+enum class PlanPriority {
+  kNormal,
+  kUrgent,
+};
+
+// @brief Set to true to stop a plan, checked before it starts and between
+// IK steps
+using CancelFlag = std::shared_ptr<std::atomic<bool>>;
+// @brief Called once with the result, on a worker thread, must not throw
+using PlanCallback = std::function<void(PlanResult &&)>;
+
+/**
+ * @brief Future result of a submitted request and the means to cancel it
+ */
+struct PlanTicket {
+  std::future<PlanResult> result;
+  CancelFlag cancelFlag;
+  // @brief Ask the plan to stop, its result becomes PlanStatus::kCancelled
+  // unless it already finished
+  void cancel() const noexcept {
+    if (cancelFlag) {
+      cancelFlag->store(true, std::memory_order_relaxed);
+    }
+  }
+};
+
+/**
+ * @brief Tuning of a PlanningService
+ */
+struct PlanningServiceOptions {
+  IKOptions ikOptions;
+  // @brief Workers, 0 means one per hardware thread
+  size_t numThreads = 0;
+  // @brief Requests waiting to start, submit rejects beyond it
+  size_t queueCapacity = 64;
+  // @brief Largest accepted distance of the last waypoint from the target
+  double goalTolerance = 1E-3;
+};
+
+/**
+ * @brief Plans linearIK moves on worker threads without blocking the caller
+ * @note Requests wait in a bounded queue, urgent ones ahead of normal ones
+ * and first come first served within a priority. A full queue rejects new
+ * requests instead of blocking, so a control loop never stalls on submit.
+ * Cancellation is cooperative: a queued request is dropped when it reaches a
+ * worker, a running one stops at its next IK step. To preempt a stale plan,
+ * cancel its ticket and submit the new goal as urgent.
+ */
+class PlanningService {
+ public:
+  explicit PlanningService(
+      const PlanningServiceOptions &inOptions = PlanningServiceOptions());
+  // @brief Cancel every queued and running request and join the workers
+  ~PlanningService();
+  PlanningService(const PlanningService &) = delete;
+  PlanningService &operator=(const PlanningService &) = delete;
+
+  // @brief Queue job, ticket receives its future, false if rejected
+  bool submit(const PlanJob &job, PlanPriority priority, PlanTicket &ticket);
+  // @brief Queue job, callback receives its result, nullptr if rejected
+  CancelFlag submit(const PlanJob &job, PlanPriority priority,
+                    PlanCallback callback);
+  // @brief Requests waiting for a worker
+  size_t queued() const;
+  size_t numThreads() const noexcept { return workers.size(); }
+
+ private:
+  struct Request {
+    PlanJob job;
+    PlanPriority priority;
+    // @brief Submission order, keeps one priority first in first out
+    uint64_t sequence;
+    CancelFlag cancelFlag;
+    PlanCallback callback;
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+  using RequestPtr = std::unique_ptr<Request>;
+  // @brief Heap order, front() is the most urgent, oldest request
+  struct LaterFirst {
+    bool operator()(const RequestPtr &a, const RequestPtr &b) const noexcept {
+      return a->priority != b->priority ? a->priority < b->priority
+                                        : a->sequence > b->sequence;
+    }
+  };
+  void workerLoop();
+
+  PlanningServiceOptions options;
+  ForwardKinematics forwardKinematics;
+  std::vector<std::thread> workers;
+  // @brief Guards the fields below
+  mutable std::mutex mutex;
+  std::condition_variable requestAvailable;
+  // @brief Heap ordered by LaterFirst, with std::push_heap and std::pop_heap
+  std::vector<RequestPtr> requests;
+  // @brief Flags of the requests being planned, set on shutdown
+  std::vector<CancelFlag> running;
+  uint64_t nextSequence = 0;
+  bool stopping = false;
+};
+}  // namespace a3c
+
+#endif
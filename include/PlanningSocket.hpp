@@ -0,0 +1,100 @@
+/**
+ * @file PlanningSocket.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Unix domain socket front end of a PlanningService
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef PlanningSocket_HPP
+#define PlanningSocket_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PlanningService.hpp"
+
+namespace a3c {
+/**
+ * @brief Serves a PlanningService to other processes on the same host
+ * @note Fixed size binary frames in host byte order, so only local clients
+ * are supported. Each connection may pipeline any number of requests, tagged
+ * with a caller chosen id; results come back as they finish, not in request
+ * order; reusing an id that is still in flight is answered kRejected. A
+ * request can be cancelled by id, and a client that disconnects cancels
+ * everything it still has outstanding. Every connection has a reader
+ * and a writer thread; finished results are queued for the writer, so a
+ * client that stops reading holds up only its own results, and is
+ * disconnected once too many pile up.
+ */
+class PlanningServer {
+ public:
+  // @brief The service must outlive the server
+  explicit PlanningServer(PlanningService &inService) noexcept
+      : service(inService) {}
+  // @brief stop()
+  ~PlanningServer();
+  PlanningServer(const PlanningServer &) = delete;
+  PlanningServer &operator=(const PlanningServer &) = delete;
+
+  // @brief Bind path (replacing a stale socket file) and start accepting
+  bool listen(const std::string &path);
+  // @brief Close the listening socket and every connection, remove the file
+  void stop();
+  bool isListening() const noexcept { return listenFd >= 0; }
+
+  struct Connection;
+
+ private:
+  void acceptLoop();
+  void serve(const std::shared_ptr<Connection> &connection);
+
+  PlanningService &service;
+  std::string socketPath;
+  int listenFd = -1;
+  std::thread acceptThread;
+  // @brief Guards connections and readers
+  std::mutex mutex;
+  std::vector<std::shared_ptr<Connection>> connections;
+  std::vector<std::thread> readers;
+};
+
+/**
+ * @brief Connection to a PlanningServer
+ * @note send, cancel and receive may be called from different threads, e.g.
+ * one thread submitting and another collecting results
+ */
+class PlanningClient {
+ public:
+  PlanningClient() noexcept = default;
+  ~PlanningClient() { close(); }
+  PlanningClient(const PlanningClient &) = delete;
+  PlanningClient &operator=(const PlanningClient &) = delete;
+
+  bool connect(const std::string &path);
+  void close() noexcept;
+  bool isConnected() const noexcept { return fd >= 0; }
+  // @brief Submit job under requestId, the result arrives through receive
+  bool send(uint64_t requestId, const PlanJob &job,
+            PlanPriority priority = PlanPriority::kNormal);
+  // @brief Cancel the request submitted under requestId
+  bool cancel(uint64_t requestId);
+  // @brief Block for the next result, false if the connection broke
+  bool receive(uint64_t &requestId, PlanResult &result);
+
+ private:
+  int fd = -1;
+  // @brief Serializes frames written by send and cancel
+  std::mutex writeMutex;
+};
+}  // namespace a3c
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file RobotDescription.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Compile time DH descriptions of serial arms
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef RobotDescription_HPP
+#define RobotDescription_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace a3c {
+/**
+ * @brief One row of a modified (Craig) DH table
+ * @note The link transform is RotX(alpha) TransX(a) RotZ(theta) TransZ(d),
+ * with theta = joint angle + theta offset. Lengths in metres.
+ */
+struct DHRow {
+  double alpha;
+  double a;
+  double d;
+  double theta;
+};
+
+/**
+ * @brief sin usable in constant expressions
+ * @note Exact at multiples of pi/2, so a 0 or 1 is a literal 0 or 1 and the
+ * terms it multiplies fold away, Taylor series elsewhere.
+ */
+constexpr double constexprSin(double x) {
+  for (int k = -4; k <= 4; ++k) {
+    if (x == k * M_PI_2) {
+      return (k + 8) % 4 == 1 ? 1 : (k + 8) % 4 == 3 ? -1 : 0;
+    }
+  }
+  while (x > M_PI) {
+    x -= 2 * M_PI;
+  }
+  while (x < -M_PI) {
+    x += 2 * M_PI;
+  }
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 20; ++n) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+// @brief cos usable in constant expressions
+constexpr double constexprCos(double x) { return constexprSin(x + M_PI_2); }
+
+/**
+ * @brief DH description of the A3C 6DoF arm
+ * @note A robot description provides mNumJoints and a constexpr dhTable(),
+ * see KinematicChain
+ */
+struct A3CDescription {
+  constexpr static const size_t mNumJoints = 6;
+  static constexpr std::array<DHRow, mNumJoints> dhTable() {
+    return {{{0, 0, 0.1915, 0},
+             {-M_PI_2, 0, 0.1405, -M_PI_2},
+             {0, 0.230, -0.1415, M_PI_2},
+             {M_PI_2, 0, 0.230, 0},
+             {-M_PI_2, 0, 0.1635, 0},
+             {M_PI_2, 0, 0.1665, M_PI_2}}};
+  }
+};
+}  // namespace a3c
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file SamplingPlanner.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Joint space RRT-Connect and PRM planning around obstacles
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SamplingPlanner_HPP
+#define SamplingPlanner_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ForwardKinematics.hpp"
+#include "ThreadPool.hpp"
+
+namespace a3c {
+// @brief True if the arm may occupy a configuration, e.g. no self collision
+// and no contact with the cell. Called concurrently, must be thread safe.
+using StateValidator = std::function<bool(const JointAngles &)>;
+
+/**
+ * @brief Box of the joint space the planners sample
+ */
+struct JointLimits {
+  JointAngles lower = {{-M_PI, -M_PI, -M_PI, -M_PI, -M_PI, -M_PI}};
+  JointAngles upper = {{M_PI, M_PI, M_PI, M_PI, M_PI, M_PI}};
+};
+
+/**
+ * @brief Tuning of SamplingPlanner
+ */
+struct SamplingPlannerOptions {
+  JointLimits limits;
+  // @brief Largest joint space distance between two checked states of an
+  // edge, radians
+  double edgeResolution = 0.02;
+  // @brief Longest RRT extension, radians
+  double stepSize = 0.3;
+  // @brief RRT-Connect iterations per tree before giving up
+  size_t maxIterations = 20000;
+  // @brief Nearest roadmap nodes a PRM node or query tries to connect to
+  size_t numNeighbors = 10;
+  // @brief Workers for edge checks and parallel trees, 0 means one per
+  // hardware thread
+  size_t numThreads = 0;
+  uint32_t randomSeed = 808;
+};
+
+/**
+ * @brief Joint configurations in structure-of-arrays layout with brute
+ * force nearest neighbour search
+ * @note Each joint is one contiguous column, so a query streams six dense
+ * arrays and the distance loop runs on SIMD packets. For the few thousand
+ * nodes of a tree or roadmap this beats a tree structure, there is no
+ * pointer chasing and no rebalancing on insert.
+ */
+class ConfigurationTable {
+ public:
+  constexpr static const size_t mNumJoints = ForwardKinematics::mNumDHRows;
+
+  void add(const JointAngles &q);
+  void clear() noexcept;
+  void reserve(size_t count);
+  size_t size() const noexcept { return columns[0].size(); }
+  JointAngles operator[](size_t i) const noexcept;
+  // @brief Angles of one joint for every entry
+  const std::vector<double> &column(size_t joint) const noexcept {
+    return columns[joint];
+  }
+  // @brief Index of the closest configuration, size() if empty
+  size_t nearest(const JointAngles &q) const noexcept;
+  // @brief Indices of the k closest configurations, closest first
+  void kNearest(const JointAngles &q, size_t k,
+                std::vector<size_t> &indices) const;
+
+ private:
+  // @brief Squared distances of entries [begin, begin + count) to q
+  void distances(const JointAngles &q, size_t begin, size_t count,
+                 double *out) const noexcept;
+
+  std::array<std::vector<double>, mNumJoints> columns;
+};
+
+/**
+ * @brief PRM roadmap, valid configurations and the valid edges between them
+ * @note Edges are stored as compressed rows: the neighbours of node i are
+ * neighbors[offsets[i]] .. neighbors[offsets[i + 1] - 1], every edge in both
+ * directions. A roadmap only holds for the validator it was built with, so
+ * rebuild it when the cell changes.
+ */
+struct Roadmap {
+  ConfigurationTable nodes;
+  std::vector<uint64_t> offsets;
+  std::vector<uint32_t> neighbors;
+
+  size_t numNodes() const noexcept { return nodes.size(); }
+  // @brief Undirected edges
+  size_t numEdges() const noexcept { return neighbors.size() / 2; }
+  // @brief Write to path, tagged with the DH hash of fk
+  bool save(const std::string &path, const ForwardKinematics &fk) const;
+  // @brief Read a roadmap written by save for the same arm
+  bool load(const std::string &path, const ForwardKinematics &fk);
+};
+
+/**
+ * @brief Collision free joint space paths between two configurations
+ * @note rrtConnect grows one pair of trees per worker with different random
+ * streams and returns the first connection, so a query finishes with the
+ * luckiest tree. PRM amortizes the search: buildRoadmap samples and
+ * connects the free space once, checking edges in parallel batches, then
+ * every query only attaches its end points and runs Dijkstra. Paths are the
+ * tree or roadmap vertices, consecutive ones are joined by valid straight
+ * joint space segments, see interpolate.
+ */
+class SamplingPlanner {
+ public:
+  explicit SamplingPlanner(
+      StateValidator inValidator,
+      const SamplingPlannerOptions &inOptions = SamplingPlannerOptions());
+
+  // @brief Every state within edgeResolution along a to b is valid
+  bool motionValid(const JointAngles &a, const JointAngles &b) const;
+  // @brief Path from start to goal with RRT-Connect, false if none was found
+  // within maxIterations
+  bool rrtConnect(const JointAngles &start, const JointAngles &goal,
+                  std::vector<JointAngles> &path);
+  // @brief Sample numSamples valid configurations and connect each to its
+  // numNeighbors nearest
+  void buildRoadmap(size_t numSamples, Roadmap &roadmap);
+  // @brief Shortest roadmap path from start to goal, false if they cannot be
+  // attached or lie in different components
+  bool query(const Roadmap &roadmap, const JointAngles &start,
+             const JointAngles &goal, std::vector<JointAngles> &path);
+  // @brief Insert states so no two consecutive ones are more than maxStep
+  // apart
+  static std::vector<JointAngles> interpolate(
+      const std::vector<JointAngles> &path, double maxStep);
+  size_t numThreads() const noexcept { return pool.size(); }
+
+ private:
+  // @brief Uniform sample of the joint limits
+  JointAngles sample(std::mt19937_64 &rng) const;
+
+  StateValidator validator;
+  SamplingPlannerOptions options;
+  ThreadPool pool;
+  // @brief Advances per rrtConnect call so repeated queries explore
+  // differently
+  uint64_t queryCount = 0;
+};
+}  // namespace a3c
+
+#endif
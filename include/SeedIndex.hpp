@@ -0,0 +1,87 @@
+/**
+ * @file SeedIndex.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Memory mapped voxel index of FK samples for IK seeds and reachability
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SeedIndex_HPP
+#define SeedIndex_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ForwardKinematics.hpp"
+#include "MappedFile.hpp"
+
+namespace a3c {
+/**
+ * @brief Parameters of an offline SeedIndex build
+ */
+struct SeedIndexOptions {
+  // @brief Random joint configurations sampled
+  size_t numSamples = 100000;
+  // @brief Edge of a voxel, metres
+  double cellSize = 0.05;
+  // @brief Seed of the sampler, the same seed builds the same file
+  uint64_t randomSeed = 808;
+};
+
+/**
+ * @brief One FK sample as stored in the file
+ */
+struct SeedEntry {
+  double position[3];
+  // @brief Quaternion x, y, z, w
+  double orientation[4];
+  double jointAngles[6];
+};
+
+struct SeedIndexHeader;
+
+/**
+ * @brief Voxel grid of FK samples, built offline and memory mapped at startup
+ * @note File layout: a SeedIndexHeader, the first entry of every cell
+ * (numCells + 1 uint64 offsets, compressed sparse row), then the SeedEntry
+ * records sorted by cell. Nothing is parsed or copied on open, a query
+ * visits the voxel of the target and rings of voxels around it until no
+ * closer sample can exist. The header carries the DH hash of the arm, an
+ * index built for another table is rejected.
+ */
+class SeedIndex {
+ public:
+  // @brief Sample fk and write an index file to path, false on I/O error
+  static bool build(const std::string &path, const ForwardKinematics &fk,
+                    const SeedIndexOptions &options = SeedIndexOptions());
+  // @brief Map an index file built for fk, false if it is missing, truncated,
+  // inconsistent or built for another DH table
+  bool open(const std::string &path, const ForwardKinematics &fk);
+  // @brief Unmap the file
+  void close() noexcept;
+  bool isOpen() const noexcept { return file.isOpen(); }
+  /**
+   * @brief Joint angles of the stored sample closest to target
+   * @param orientationWeight Metres of position error equivalent to one
+   * radian of orientation error
+   * @return false if the index is closed or empty
+   */
+  bool nearestSeed(const Pose &target, JointAngles &seed,
+                   double orientationWeight = 0.05) const noexcept;
+  // @brief True if some sample falls in the voxel of position
+  bool isReachable(const Eigen::Vector3d &position) const noexcept;
+  size_t numEntries() const noexcept;
+
+ private:
+  MappedFile file;
+  const SeedIndexHeader *header = nullptr;
+  const uint64_t *cellOffsets = nullptr;
+  const SeedEntry *entries = nullptr;
+};
+}  // namespace a3c
+
+#endif
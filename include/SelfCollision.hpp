@@ -0,0 +1,87 @@
+/**
+ * @file SelfCollision.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Self-collision checks on capsule link models
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SelfCollision_HPP
+#define SelfCollision_HPP
+
+#include <array>
+#include <cstddef>
+#include <eigen3/Eigen/Dense>
+#include <utility>
+#include <vector>
+
+#include "ForwardKinematics.hpp"
+#include "IncrementalForwardKinematics.hpp"
+
+namespace a3c {
+/**
+ * @brief Capsule radius of every link
+ * @note Link i is the segment from the origin of frame i to the origin of
+ * frame i + 1, so link 0 is the base column and link 5 the wrist flange
+ */
+struct CapsuleModel {
+  std::array<double, ForwardKinematics::mNumDHRows> radii = {
+      {0.04, 0.04, 0.04, 0.04, 0.04, 0.04}};
+};
+
+/**
+ * @brief Capsule self-collision checker
+ * @note Every pair of non-adjacent links is tested. The pairs are the lanes of
+ * fixed size Eigen arrays and the segment-segment distance is computed
+ * branch free (clamped closest points, Ericson), so one call evaluates all
+ * pairs with SIMD. Link frames come from IncrementalForwardKinematics, along
+ * a trajectory only the joints that changed are recomputed. All methods are
+ * const, one checker can be shared between threads.
+ */
+class SelfCollision {
+ public:
+  constexpr static const size_t mNumLinks = ForwardKinematics::mNumDHRows;
+  // @brief Non-adjacent link pairs
+  constexpr static const size_t mNumPairs =
+      (mNumLinks - 1) * (mNumLinks - 2) / 2;
+  // @brief mNumPairs rounded up to whole SIMD packets, spare lanes never
+  // collide
+  constexpr static const size_t mNumLanes = (mNumPairs + 3) / 4 * 4;
+  using Lanes = Eigen::Array<double, mNumLanes, 1>;
+
+  explicit SelfCollision(const ForwardKinematics &fk = ForwardKinematics(),
+                         const CapsuleModel &inModel = CapsuleModel());
+  // @brief Smallest surface distance over all pairs, negative if capsules
+  // overlap
+  double clearance(const JointAngles &jointAngles) const noexcept;
+  bool inCollision(const JointAngles &jointAngles) const noexcept;
+  // @brief Index of the first colliding waypoint, trajectory.size() if the
+  // whole trajectory is free. Stops at the first collision.
+  size_t firstCollision(
+      const std::vector<JointAngles> &trajectory) const noexcept;
+  // @brief Link indices of pair lane k
+  const std::pair<size_t, size_t> &pair(size_t k) const noexcept {
+    return pairs[k];
+  }
+
+ private:
+  // @brief Segment to segment distance of every lane for the frames of fk
+  Lanes distances(const IncrementalForwardKinematics &fk) const noexcept;
+
+  CapsuleModel model;
+  // @brief Evaluator with the link geometry, copied per call so that the
+  // checker holds no per query state
+  IncrementalForwardKinematics prototype;
+  std::array<std::pair<size_t, size_t>, mNumLanes> pairs;
+  // @brief ri + rj per lane, 0 in spare lanes
+  Lanes radiusSums;
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+}  // namespace a3c
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * @file SimdMath.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Branch free math kernels over Eigen lane arrays
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SimdMath_HPP
+#define SimdMath_HPP
+
+#include <eigen3/Eigen/Dense>
+
+namespace a3c {
+/**
+ * @brief Sine and cosine of every lane of x
+ * @note Cody-Waite reduction to [-pi/4, pi/4] followed by the fdlibm minimax
+ * polynomials. There are no branches, so Eigen maps every operation onto
+ * packet instructions. Accurate to a few ulp for |x| < 1e5.
+ * @param x Angles in radians
+ * @param sinX Output, sin(x)
+ * @param cosX Output, cos(x)
+ */
+template <typename ArrayT>
+inline void sinCos(const ArrayT &x, ArrayT &sinX, ArrayT &cosX) noexcept {
+  using Scalar = typename ArrayT::Scalar;
+  // pi/2 split in three parts so that j * part is exact
+  const Scalar pio2Hi = Scalar(1.57079632673412561417e+00);
+  const Scalar pio2Mid = Scalar(6.07710050630396597660e-11);
+  const Scalar pio2Lo = Scalar(2.02226624879595063154e-21);
+  const Scalar twoOverPi = Scalar(6.36619772367581382433e-01);
+
+  const ArrayT j = (x * twoOverPi + Scalar(0.5)).floor();
+  const ArrayT r = ((x - j * pio2Hi) - j * pio2Mid) - j * pio2Lo;
+  const ArrayT z = r * r;
+
+  const ArrayT sinR =
+      r + r * z *
+              (Scalar(-1.66666666666666324348e-01) +
+               z * (Scalar(8.33333333332248946124e-03) +
+                    z * (Scalar(-1.98412698298579493134e-04) +
+                         z * (Scalar(2.75573137070700676789e-06) +
+                              z * (Scalar(-2.50507602534068634195e-08) +
+                                   z * Scalar(1.58969099521155010221e-10))))));
+  const ArrayT cosR =
+      Scalar(1) - Scalar(0.5) * z +
+      z * z *
+          (Scalar(4.16666666666666019037e-02) +
+           z * (Scalar(-1.38888888888741095749e-03) +
+                z * (Scalar(2.48015872894767294178e-05) +
+                     z * (Scalar(-2.75573143513906633035e-07) +
+                          z * (Scalar(2.08757232129817482790e-09) +
+                               z * Scalar(-1.13596475577881948265e-11))))));
+
+  // Quadrant q = j mod 4 decides swap and signs:
+  // q=0: ( s,  c)  q=1: ( c, -s)  q=2: (-s, -c)  q=3: (-c,  s)
+  const ArrayT q = j - Scalar(4) * (j * Scalar(0.25)).floor();
+  const ArrayT odd = q - Scalar(2) * (q * Scalar(0.5)).floor();
+  const ArrayT upper = (q * Scalar(0.5)).floor();
+  const ArrayT sinSign = Scalar(1) - Scalar(2) * upper;
+  const ArrayT cosSign =
+      Scalar(1) - Scalar(2) * (odd + upper - Scalar(2) * odd * upper);
+  sinX = sinSign * (sinR + odd * (cosR - sinR));
+  cosX = cosSign * (cosR + odd * (sinR - cosR));
+}
+}  // namespace a3c
+
+#endif
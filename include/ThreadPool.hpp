@@ -0,0 +1,74 @@
+/**
+ * @file ThreadPool.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Work-stealing pool of worker threads
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef ThreadPool_HPP
+#define ThreadPool_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace a3c {
+/**
+ * @brief Fixed set of worker threads running indexed tasks
+ * @note Each worker owns a deque of task indices. It pops from the back of its
+ * own deque and, once that is empty, steals from the front of the others, so
+ * a worker that drew short tasks takes over the remainder of a slow one.
+ * parallelFor calls are serialized, one batch runs at a time.
+ */
+class ThreadPool {
+ public:
+  // @brief Start numThreads workers, 0 means one per hardware thread
+  explicit ThreadPool(size_t numThreads = 0);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // @brief Number of worker threads
+  size_t size() const noexcept { return workers.size(); }
+  /**
+   * @brief Run body(i) for every i in [0, count) and wait for all of them
+   * @note body is called concurrently from the workers and must not throw
+   */
+  void parallelFor(size_t count, const std::function<void(size_t)> &body);
+
+ private:
+  // @brief Task indices of one worker, guarded by its own mutex
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<size_t> tasks;
+  };
+  void workerLoop(size_t self);
+  // @brief Next task for worker self, own queue first, then stolen
+  bool takeTask(size_t self, size_t &task);
+
+  std::vector<std::thread> workers;
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  // @brief Serializes parallelFor callers
+  std::mutex batchMutex;
+  // @brief Guards the fields below
+  std::mutex stateMutex;
+  std::condition_variable workAvailable;
+  std::condition_variable batchDone;
+  const std::function<void(size_t)> *body = nullptr;
+  size_t generation = 0;
+  size_t pending = 0;
+  size_t activeWorkers = 0;
+  bool stopping = false;
+};
+}  // namespace a3c
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file TimeParameterization.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Time optimal retiming of joint paths under velocity and
+ * acceleration limits
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef TimeParameterization_HPP
+#define TimeParameterization_HPP
+
+#include <vector>
+
+#include "InverseKinematics.hpp"
+
+namespace a3c {
+/**
+ * @brief Symmetric per joint limits, rad/s and rad/s^2
+ */
+struct KinematicLimits {
+  JointAngles maxVelocity = {{M_PI, M_PI, M_PI, M_PI, M_PI, M_PI}};
+  JointAngles maxAcceleration = {
+      {2 * M_PI, 2 * M_PI, 2 * M_PI, 2 * M_PI, 2 * M_PI, 2 * M_PI}};
+};
+
+/**
+ * @brief A joint path with the fastest timing its limits allow
+ * @note waypoints is the input path without repeated waypoints, long
+ * segments subdivided. The arm follows its quadratic B-spline, which starts
+ * and ends on the first and last waypoint and rounds every other one off, see
+ * timeParameterize(). The timing grid is where its pieces meet: the first
+ * waypoint, every chord midpoint and the last waypoint. Path speed is about the
+ * joint space distance covered per second. Between two grid points the path
+ * acceleration is constant, so positions in between follow from the speeds
+ * in closed form instead of being interpolated in time.
+ */
+struct TimedTrajectory {
+  std::vector<JointAngles> waypoints;
+  // @brief Time each grid point is passed, seconds from the start: entry 0
+  // at the first waypoint, entry i + 1 halfway along chord i, the last entry
+  // at the last waypoint
+  std::vector<double> times;
+  // @brief Path speed at each grid point, 0 at both ends
+  std::vector<double> speeds;
+
+  double duration() const noexcept {
+    return times.empty() ? 0.0 : times.back();
+  }
+  // @brief Joint angles at time t, clamped to [0, duration()]
+  JointAngles sample(double t) const noexcept;
+  // @brief Joint angles every period seconds, first and last waypoint
+  // included, e.g. for a fixed rate controller
+  std::vector<JointAngles> resample(double period) const;
+
+ private:
+  // @brief Joint angles at time t within grid interval k
+  JointAngles sampleInterval(size_t k, double t) const noexcept;
+};
+
+// @brief Time optimal timing of path from rest to rest, segments longer than
+// maxGridStep radians are subdivided. False if the path is empty or a limit
+// is not positive.
+bool timeParameterize(const std::vector<JointAngles> &path,
+                      const KinematicLimits &limits,
+                      TimedTrajectory &trajectory, double maxGridStep = 0.01);
+}  // namespace a3c
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file TrajectoryCompression.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Spline compression of joint trajectories under error bounds
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef TrajectoryCompression_HPP
+#define TrajectoryCompression_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "ForwardKinematics.hpp"
+
+namespace a3c {
+/**
+ * @brief Error bounds of a compressed trajectory against the original
+ */
+struct CompressionOptions {
+  // @brief Largest joint deviation at any original waypoint, radians
+  double jointTolerance = 1E-3;
+  // @brief Largest end effector position deviation, metres, checked with FK
+  double cartesianTolerance = 1E-4;
+};
+
+/**
+ * @brief Knot of a cubic Hermite spline in joint space
+ */
+struct SplineKnot {
+  double timeSecs;
+  JointAngles angles;
+  // @brief Joint velocities at the knot, radians per second
+  JointAngles velocities;
+};
+
+/**
+ * @brief Joint trajectory as a piecewise cubic Hermite spline
+ * @note Positions and velocities are continuous across knots. Sample it at
+ * any rate with sample() or resample().
+ */
+class CompressedTrajectory {
+ public:
+  CompressedTrajectory() noexcept = default;
+  explicit CompressedTrajectory(std::vector<SplineKnot> inKnots) noexcept
+      : knots(std::move(inKnots)) {}
+  // @brief Joint angles at timeSecs, clamped to the ends of the trajectory
+  JointAngles sample(double timeSecs) const noexcept;
+  // @brief Samples every timeStepSecs from the first to the last knot, the
+  // last knot always included
+  std::vector<JointAngles> resample(double timeStepSecs) const;
+  double durationSecs() const noexcept {
+    return knots.empty() ? 0 : knots.back().timeSecs - knots.front().timeSecs;
+  }
+  const std::vector<SplineKnot> &getKnots() const noexcept { return knots; }
+  // @brief Bytes of knot data
+  size_t byteSize() const noexcept { return knots.size() * sizeof(SplineKnot); }
+
+ private:
+  std::vector<SplineKnot> knots;
+};
+
+/**
+ * @brief Fits splines to dense trajectories such as linearIK output
+ * @note Knots are placed greedily: from the last knot the next one is pushed
+ * as far along the trajectory as the bounds allow (doubling, then bisection).
+ * Knot velocities are finite differences of the original samples. Every
+ * accepted segment is checked at each original waypoint in between, in joint
+ * space and through FK, so the bounds hold at every original sample.
+ */
+class TrajectoryCompressor {
+ public:
+  explicit TrajectoryCompressor(
+      const CompressionOptions &inOptions = CompressionOptions()) noexcept
+      : options(inOptions) {}
+  /**
+   * @brief Compress waypoints spaced timeStepSecs apart
+   * @param trajectory Dense waypoints, e.g. InverseKinematics::linearIK
+   * @param timeStepSecs Time between waypoints
+   */
+  CompressedTrajectory compress(const std::vector<JointAngles> &trajectory,
+                                double timeStepSecs = 0.001) const;
+
+ private:
+  // @brief True if the segment between waypoints first and last stays within
+  // the bounds at every waypoint in between
+  bool segmentFits(const std::vector<JointAngles> &trajectory,
+                   const SplineKnot &start, const SplineKnot &end,
+                   size_t first, size_t last,
+                   double timeStepSecs) const noexcept;
+  // @brief Knot at waypoint index with its finite difference velocity
+  static SplineKnot knotAt(const std::vector<JointAngles> &trajectory,
+                           size_t index, double timeStepSecs) noexcept;
+
+  CompressionOptions options;
+  ForwardKinematics forwardKinematics;
+};
+}  // namespace a3c
+
+#endif
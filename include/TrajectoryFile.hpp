@@ -0,0 +1,119 @@
+/**
+ * @file TrajectoryFile.hpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Binary trajectory library files, streaming writer and mmap reader
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef TrajectoryFile_HPP
+#define TrajectoryFile_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ForwardKinematics.hpp"
+#include "InverseKinematics.hpp"
+#include "MappedFile.hpp"
+
+namespace a3c {
+/**
+ * @brief Fixed size header at the start of a trajectory file
+ * @note File layout, native byte order:
+ * header | numWaypoints x 6 doubles | numSegments x uint64 first waypoint
+ * of each segment. A segment is one trajectory of the library.
+ */
+struct TrajectoryFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t numJoints;
+  // @brief ForwardKinematics::dhHash of the arm the angles belong to
+  uint64_t dhHash;
+  double timeStepSecs;
+  uint64_t numWaypoints;
+  uint64_t numSegments;
+};
+
+/**
+ * @brief Appends trajectories to a file one waypoint block at a time
+ * @note Memory does not grow with the file. The header and the segment table
+ * are written by close(), a file that was not closed is rejected by the
+ * reader.
+ */
+class TrajectoryWriter {
+ public:
+  TrajectoryWriter() = default;
+  ~TrajectoryWriter() { close(); }
+  TrajectoryWriter(const TrajectoryWriter &) = delete;
+  TrajectoryWriter &operator=(const TrajectoryWriter &) = delete;
+
+  // @brief Create path for trajectories of fk sampled every timeStepSecs
+  bool open(const std::string &path, const ForwardKinematics &fk,
+            double timeStepSecs = 0.001);
+  // @brief Start a new segment, later waypoints belong to it
+  void beginSegment();
+  // @brief Append one waypoint to the current segment
+  bool write(const JointAngles &waypoint);
+  // @brief Append a whole trajectory as its own segment
+  bool writeSegment(const std::vector<JointAngles> &trajectory);
+  // @brief Drain a linearIK generator into its own segment without building
+  // the vector. Returns the number of waypoints written.
+  size_t writeSegment(TrajectoryGenerator &generator);
+  // @brief Write the segment table and the header, false on I/O error
+  bool close();
+  bool isOpen() const noexcept { return out.is_open(); }
+
+ private:
+  std::ofstream out;
+  TrajectoryFileHeader header;
+  std::vector<uint64_t> segmentStarts;
+};
+
+/**
+ * @brief Waypoints of one segment, pointing into the mapping
+ */
+struct TrajectoryView {
+  const JointAngles *waypoints = nullptr;
+  size_t size = 0;
+  const JointAngles *begin() const noexcept { return waypoints; }
+  const JointAngles *end() const noexcept { return waypoints + size; }
+  const JointAngles &operator[](size_t i) const noexcept {
+    return waypoints[i];
+  }
+};
+
+/**
+ * @brief Zero-copy reader of trajectory files
+ * @note open() maps the file and validates header, size and DH hash, after
+ * that waypoints are read straight from the page cache
+ */
+class TrajectoryReader {
+ public:
+  // @brief Map a file written for fk, false if it is invalid or for another
+  // arm
+  bool open(const std::string &path, const ForwardKinematics &fk);
+  void close() noexcept;
+  bool isOpen() const noexcept { return file.isOpen(); }
+  size_t numSegments() const noexcept;
+  size_t numWaypoints() const noexcept;
+  double timeStepSecs() const noexcept;
+  // @brief Waypoints of segment i
+  TrajectoryView segment(size_t i) const noexcept;
+  // @brief Every waypoint of the file, segments back to back
+  TrajectoryView all() const noexcept;
+
+ private:
+  MappedFile file;
+  const TrajectoryFileHeader *header = nullptr;
+  const JointAngles *waypoints = nullptr;
+  const uint64_t *segmentStarts = nullptr;
+};
+}  // namespace a3c
+
+#endif
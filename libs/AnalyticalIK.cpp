@@ -0,0 +1,615 @@
+/**
+ * @file AnalyticalIK.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Analytical inverse kinematics of the A3C arm
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/AnalyticalIK.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace a3c {
+namespace {
+using FK = ForwardKinematics;
+// @brief Rounding allowed on cos(theta3) at the reach limit, where the arcs of
+// reachableArcs() begin and end
+constexpr double kReachSlack = 1E-9;
+// @brief Wrist distance from the joint 1 axis below which an arc is split at
+// the closest point, metres. Joint 1 turns fast there and the residual with
+// it, the split packs grid points around it.
+constexpr double kAxisProximity = 0.02;
+// @brief Fewest grid cells of a short arc
+constexpr size_t kMinArcCells = 16;
+// @brief Deepest halving of a grid cell in AnalyticalIK::solveArc()
+constexpr size_t kMaxSplits = 12;
+// @brief How much closer to zero than its curvature the parabola model of a
+// cell may come before the cell is split, AnalyticalIK::solveArc()
+constexpr double kHiddenMargin = 4;
+
+/**
+ * @brief Interval [a, b] of the arc coordinate with the residual at both ends
+ * and the middle m
+ */
+struct Span {
+  double a;
+  double fa;
+  double m;
+  double fm;
+  double b;
+  double fb;
+  size_t depth;
+};
+
+/**
+ * @brief Unreachable interval [begin, begin + length] of the circle angle, or
+ * a split point if length is 0
+ */
+struct Cut {
+  double begin;
+  double length;
+};
+
+/**
+ * @brief Angle wrapped to [-pi, pi]
+ */
+double wrapAngle(double angle) noexcept {
+  return std::remainder(angle, 2 * M_PI);
+}
+
+/**
+ * @brief Largest wrapped difference between two configurations
+ */
+double maxAngleDistance(const JointAngles &a, const JointAngles &b) noexcept {
+  double distance = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    distance = std::max(distance, std::abs(wrapAngle(a[i] - b[i])));
+  }
+  return distance;
+}
+}  // namespace
+
+/**
+ * @brief Construct a new AnalyticalIK object
+ *
+ * @param fk Source of the DH table, expected to have the A3C structure
+ */
+AnalyticalIK::AnalyticalIK(const ForwardKinematics &fk) noexcept
+    : forwardKinematics(fk) {
+  const auto &dh = fk.getDHTable();
+  d1 = dh(0, FK::dIndex);
+  lateralOffset = dh(1, FK::dIndex) + dh(2, FK::dIndex);
+  a2 = dh(2, FK::aIndex);
+  d4 = dh(3, FK::dIndex);
+  d5 = dh(4, FK::dIndex);
+  d6 = dh(5, FK::dIndex);
+}
+
+/**
+ * @brief Circle angle at grid coordinate u
+ * @note On a partial arc the grid is dense toward both ends: near the reach
+ * limit the residual grows with the square root of the distance to it, in u
+ * it is smooth.
+ */
+double AnalyticalIK::Arc::angle(double u) const noexcept {
+  return whole ? begin + length * u
+               : begin + 0.5 * length * (1 - std::cos(M_PI * u));
+}
+
+/**
+ * @brief Arcs of the circle angle on which the arm reaches the wrist point
+ * @note Shoulder to wrist distance squared, reach^2 + height^2 in solveArm,
+ * is |W - (0, 0, d1)|^2 - lateralOffset^2. W moves on a circle, so it is
+ * mean + amplitude * cos(phi - center), and the elbow limits
+ * (a2 - d4)^2 <= distance^2 <= (a2 + d4)^2 cut at most two gaps from the
+ * circle in closed form. The squared distance of W from the joint 1 axis is
+ * smooth, its minima are found on the grid and refined: below lateralOffset
+ * the gap around one is bisected and split points are set a gap width beyond
+ * its edges, within kAxisProximity the minimum is a split point.
+ * Arcs are what lies between the gaps and split points.
+ * @param arcs Output, the first return value entries are set
+ */
+size_t AnalyticalIK::reachableArcs(
+    const Eigen::Vector3d &crossing, const Matrix3d &R,
+    std::array<Arc, mMaxArcs> &arcs) const noexcept {
+  std::array<Cut, mMaxArcs> cuts;
+  size_t numCuts = 0;
+
+  const Eigen::Vector3d shoulder = crossing - Eigen::Vector3d(0, 0, d1);
+  const double mean = shoulder.squaredNorm() + d5 * d5 -
+                      lateralOffset * lateralOffset;
+  const double cosine = -2 * d5 * shoulder.dot(R.col(0));
+  const double sine = -2 * d5 * shoulder.dot(R.col(1));
+  const double amplitude = std::hypot(cosine, sine);
+  const double center = std::atan2(sine, cosine);
+  const double shortest = (a2 - d4) * (a2 - d4);
+  const double longest = (a2 + d4) * (a2 + d4);
+  if (mean + amplitude < shortest || mean - amplitude > longest) {
+    return 0;
+  }
+  // Reachable where outer <= |phi - center| <= inner
+  if (mean + amplitude > longest) {
+    const double outer = std::acos((longest - mean) / amplitude);
+    cuts[numCuts++] = {center - outer, 2 * outer};
+  }
+  if (mean - amplitude < shortest) {
+    const double inner = std::acos((shortest - mean) / amplitude);
+    cuts[numCuts++] = {center + inner, 2 * (M_PI - inner)};
+  }
+
+  auto axisDistance2 = [&](double phi) {
+    const Eigen::Vector3d wrist =
+        crossing - d5 * (std::cos(phi) * R.col(0) + std::sin(phi) * R.col(1));
+    return wrist.x() * wrist.x() + wrist.y() * wrist.y();
+  };
+  const double spacing = 2 * M_PI / mNumSamples;
+  const double lateral2 = lateralOffset * lateralOffset;
+  std::array<double, mNumSamples> grid;
+  for (size_t k = 0; k < mNumSamples; ++k) {
+    grid[k] = axisDistance2(spacing * static_cast<double>(k));
+  }
+  for (size_t k = 0; k < mNumSamples && numCuts + 3 <= cuts.size(); ++k) {
+    const size_t previous = (k + mNumSamples - 1) % mNumSamples;
+    const size_t next = (k + 1) % mNumSamples;
+    if (grid[k] > grid[previous] || grid[k] >= grid[next]) {
+      continue;
+    }
+    const double golden = 0.5 * (std::sqrt(5.0) - 1);
+    double a = spacing * (static_cast<double>(k) - 1);
+    double b = spacing * (static_cast<double>(k) + 1);
+    double c = b - golden * (b - a);
+    double d = a + golden * (b - a);
+    double fc = axisDistance2(c);
+    double fd = axisDistance2(d);
+    for (int iteration = 0; iteration < 40; ++iteration) {
+      if (fc < fd) {
+        b = d;
+        d = c;
+        fd = fc;
+        c = b - golden * (b - a);
+        fc = axisDistance2(c);
+      } else {
+        a = c;
+        c = d;
+        fc = fd;
+        d = a + golden * (b - a);
+        fd = axisDistance2(d);
+      }
+    }
+    const double minimum = fc < fd ? c : d;
+    const double fMinimum = std::min(fc, fd);
+    if (fMinimum >= kAxisProximity * kAxisProximity) {
+      continue;
+    }
+    if (fMinimum > lateral2) {
+      cuts[numCuts++] = {minimum, 0};
+      continue;
+    }
+    // Walk out to reachable grid points, then bisect for the gap edges,
+    // keeping the reachable side
+    double edges[2];
+    for (int side = 0; side < 2; ++side) {
+      const double direction = side ? 1 : -1;
+      double outside = minimum + direction * spacing;
+      for (size_t step = 0;
+           step < mNumSamples && axisDistance2(outside) <= lateral2; ++step) {
+        outside += direction * spacing;
+      }
+      if (axisDistance2(outside) <= lateral2) {
+        return 0;
+      }
+      double inside = minimum;
+      for (int iteration = 0; iteration < 48; ++iteration) {
+        const double middle = 0.5 * (inside + outside);
+        (axisDistance2(middle) > lateral2 ? outside : inside) = middle;
+      }
+      edges[side] = outside;
+    }
+    // Joint 1 turns fast within about the gap width of its edges, split
+    // points there pack grid points around the edges
+    const double width = edges[1] - edges[0];
+    cuts[numCuts++] = {edges[0], width};
+    cuts[numCuts++] = {edges[0] - width, 0};
+    cuts[numCuts++] = {edges[1] + width, 0};
+  }
+
+  if (numCuts == 0) {
+    arcs[0] = {0, 2 * M_PI, true};
+    return 1;
+  }
+  // Order the cuts along the circle from the first, merge overlapping ones
+  const double origin = cuts[0].begin;
+  for (size_t i = 0; i < numCuts; ++i) {
+    double offset = std::fmod(cuts[i].begin - origin, 2 * M_PI);
+    cuts[i].begin = origin + (offset < 0 ? offset + 2 * M_PI : offset);
+  }
+  std::sort(cuts.begin(), cuts.begin() + numCuts,
+            [](const Cut &a, const Cut &b) { return a.begin < b.begin; });
+  size_t numMerged = 0;
+  for (size_t i = 0; i < numCuts; ++i) {
+    Cut &last = cuts[numMerged - (numMerged > 0)];
+    if (numMerged > 0 && cuts[i].begin <= last.begin + last.length) {
+      last.length = std::max(last.length,
+                             cuts[i].begin + cuts[i].length - last.begin);
+    } else {
+      cuts[numMerged++] = cuts[i];
+    }
+  }
+  size_t numArcs = 0;
+  for (size_t i = 0; i < numMerged; ++i) {
+    const double begin = cuts[i].begin + cuts[i].length;
+    const double end = i + 1 < numMerged ? cuts[i + 1].begin
+                                         : cuts[0].begin + 2 * M_PI;
+    if (end > begin) {
+      arcs[numArcs++] = {begin, end - begin, false};
+    }
+  }
+  return numArcs;
+}
+
+/**
+ * @brief Joints 1-3 placing the wrist point
+ * @note Joint 1 turns the arm plane so the wrist sits lateralOffset beside it
+ * (two shoulder branches), joints 2 and 3 are a planar two link problem with
+ * links a2 and d4 in that plane (two elbow branches).
+ * @param wrist Target of the axis 4/5 crossing, base frame
+ * @param branch 0..3, bit 0 picks the shoulder, bit 1 the elbow
+ */
+bool AnalyticalIK::solveArm(const Eigen::Vector3d &wrist, size_t branch,
+                            double &theta1, double &theta2,
+                            double &theta3) const noexcept {
+  const double radius = std::hypot(wrist.x(), wrist.y());
+  if (radius <= std::abs(lateralOffset)) {
+    return false;
+  }
+  const double azimuth = std::atan2(wrist.y(), wrist.x());
+  const double tilt = std::asin(lateralOffset / radius);
+  theta1 = (branch & 1) ? azimuth + tilt - M_PI : azimuth - tilt;
+  const double reach =
+      wrist.x() * std::cos(theta1) + wrist.y() * std::sin(theta1);
+  const double height = wrist.z() - d1;
+  double cosTheta3 =
+      (reach * reach + height * height - a2 * a2 - d4 * d4) / (2 * a2 * d4);
+  if (std::abs(cosTheta3) > 1 + kReachSlack) {
+    return false;
+  }
+  cosTheta3 = std::max(-1.0, std::min(1.0, cosTheta3));
+  theta3 = ((branch & 2) ? -1 : 1) * std::acos(cosTheta3);
+  theta2 = std::atan2(reach, height) -
+           std::atan2(d4 * std::sin(theta3), a2 + d4 * cosTheta3);
+  return true;
+}
+
+/**
+ * @brief Cosine between forearm and axis 5 of every arm branch
+ * @note Same construction as solveArm, written with angle sum identities so
+ * that no trigonometric function is evaluated: the elbow is the wrist
+ * direction in the arm plane turned back by the elbow triangle angle.
+ * @return Residuals 0 at a solution, NaN where the wrist point is unreachable
+ */
+AnalyticalIK::Residuals AnalyticalIK::residuals(const Eigen::Vector3d &crossing,
+                                                const Matrix3d &R,
+                                                double cosPhi,
+                                                double sinPhi) const noexcept {
+  Residuals result;
+  result.fill(std::numeric_limits<double>::quiet_NaN());
+  const Eigen::Vector3d axis5 = cosPhi * R.col(0) + sinPhi * R.col(1);
+  const Eigen::Vector3d wrist = crossing - d5 * axis5;
+  const double radius = std::hypot(wrist.x(), wrist.y());
+  if (radius <= std::abs(lateralOffset)) {
+    return result;
+  }
+  const double cosAzimuth = wrist.x() / radius;
+  const double sinAzimuth = wrist.y() / radius;
+  const double sinTilt = lateralOffset / radius;
+  const double cosTilt = std::sqrt(1 - sinTilt * sinTilt);
+  const double height = wrist.z() - d1;
+  for (size_t shoulder = 0; shoulder < 2; ++shoulder) {
+    // theta1 = azimuth - tilt, or azimuth + tilt - pi
+    const double cosTheta1 =
+        shoulder ? -(cosAzimuth * cosTilt - sinAzimuth * sinTilt)
+                 : cosAzimuth * cosTilt + sinAzimuth * sinTilt;
+    const double sinTheta1 =
+        shoulder ? -(sinAzimuth * cosTilt + cosAzimuth * sinTilt)
+                 : sinAzimuth * cosTilt - cosAzimuth * sinTilt;
+    const double reach = wrist.x() * cosTheta1 + wrist.y() * sinTheta1;
+    const double distance = std::hypot(reach, height);
+    double cosTheta3 =
+        (distance * distance - a2 * a2 - d4 * d4) / (2 * a2 * d4);
+    if (std::abs(cosTheta3) > 1 + kReachSlack || distance == 0) {
+      continue;
+    }
+    cosTheta3 = std::max(-1.0, std::min(1.0, cosTheta3));
+    const double axis5Reach = axis5.x() * cosTheta1 + axis5.y() * sinTheta1;
+    const double unitReach = reach / distance;
+    const double unitHeight = height / distance;
+    for (size_t elbow = 0; elbow < 2; ++elbow) {
+      const double sinTheta3 =
+          (elbow ? -1 : 1) * std::sqrt(1 - cosTheta3 * cosTheta3);
+      const double cosBeta = (a2 + d4 * cosTheta3) / distance;
+      const double sinBeta = d4 * sinTheta3 / distance;
+      const double elbowReach =
+          a2 * (unitReach * cosBeta - unitHeight * sinBeta);
+      const double elbowHeight =
+          a2 * (unitHeight * cosBeta + unitReach * sinBeta);
+      result[shoulder | (elbow << 1)] =
+          ((reach - elbowReach) * axis5Reach +
+           (height - elbowHeight) * axis5.z()) /
+          d4;
+    }
+  }
+  return result;
+}
+
+double AnalyticalIK::residual(const Eigen::Vector3d &crossing,
+                              const Matrix3d &R, double phi,
+                              size_t branch) const noexcept {
+  return residuals(crossing, R, std::cos(phi), std::sin(phi))[branch];
+}
+
+/**
+ * @brief Complete a root phi to full joint angles and verify them with FK
+ * @note With joints 1-3 known, R04^T R06 = Rz(q4) Ry(q5) Rz(q6) up to the DH
+ * offsets, the two ZYZ branches are tried and FK keeps the consistent one.
+ */
+void AnalyticalIK::completeSolution(const Pose &targetPose,
+                                    const Eigen::Vector3d &crossing,
+                                    double phi, size_t branch,
+                                    IKSolutions &result) const noexcept {
+  const Matrix3d R = targetPose.orientation.toRotationMatrix();
+  const Eigen::Vector3d axis5 =
+      std::cos(phi) * R.col(0) + std::sin(phi) * R.col(1);
+  JointAngles ja = {{0, 0, 0, 0, 0, 0}};
+  if (!solveArm(crossing - d5 * axis5, branch, ja[0], ja[1], ja[2])) {
+    return;
+  }
+  const auto &dh = forwardKinematics.getDHTable();
+  Matrix4d T04 = Matrix4d::Identity();
+  for (size_t i = 0; i < 4; ++i) {
+    Eigen::Array<double, 1, FK::mNumDHCols> dhRow = dh.row(i);
+    dhRow(FK::thetaIndex) += ja[i];
+    T04 *= forwardKinematics.getTransformationMatrix(dhRow);
+  }
+  const Matrix3d M = T04.topLeftCorner<3, 3>().transpose() * R;
+
+  for (double sign : {1.0, -1.0}) {
+    const double sinQ5 = sign * std::hypot(M(0, 2), M(1, 2));
+    double q4 = 0;
+    double q6 = 0;
+    if (std::abs(sinQ5) > 1E-9) {
+      q4 = std::atan2(sign * M(1, 2), sign * M(0, 2));
+      q6 = std::atan2(sign * M(2, 1), -sign * M(2, 0));
+    } else {
+      q6 = std::atan2(M(1, 0), M(1, 1));
+    }
+    ja[3] = wrapAngle(q4);
+    ja[4] = wrapAngle(std::atan2(sinQ5, M(2, 2)) - dh(4, FK::thetaIndex));
+    ja[5] = wrapAngle(q6 - dh(5, FK::thetaIndex));
+    for (size_t i = 0; i < 3; ++i) {
+      ja[i] = wrapAngle(ja[i]);
+    }
+
+    const auto pose = forwardKinematics.fk(ja);
+    if ((pose.position - targetPose.position).norm() > 1E-6 ||
+        pose.orientation.angularDistance(targetPose.orientation) > 1E-6) {
+      continue;
+    }
+    bool duplicate = false;
+    for (size_t i = 0; i < result.count; ++i) {
+      duplicate |= maxAngleDistance(result.solutions[i], ja) < 1E-6;
+    }
+    if (!duplicate && result.count < IKSolutions::mMaxSolutions) {
+      result.solutions[result.count++] = ja;
+    }
+  }
+}
+
+/**
+ * @brief Every joint solution reaching targetPose
+ * @param targetPose Pose of the end effector
+ * @param result Output, cleared first, solutions wrapped to [-pi, pi]
+ */
+void AnalyticalIK::solve(const Pose &targetPose,
+                         IKSolutions &result) const noexcept {
+  result.count = 0;
+  const Matrix3d R = targetPose.orientation.toRotationMatrix();
+  const Eigen::Vector3d crossing = targetPose.position - d6 * R.col(2);
+  std::array<Arc, mMaxArcs> arcs;
+  const size_t numArcs = reachableArcs(crossing, R, arcs);
+  for (size_t i = 0; i < numArcs; ++i) {
+    solveArc(targetPose, crossing, R, arcs[i], result);
+  }
+}
+
+/**
+ * @brief Roots of every arm branch on one arc
+ * @note The residual of all arm branches is sampled at the ends and middle of
+ * every grid cell over the arc coordinate u. A half cell whose ends differ in
+ * sign brackets a root, refined with the Illinois variant of regula falsi.
+ * Otherwise the parabola through the cell's three samples models the
+ * residual, and the cell is split again while the parabola comes within
+ * kHiddenMargin times its own curvature of zero, which bounds how far the
+ * model may be off.
+ * Close pairs of roots and tangent roots are resolved that way down to
+ * kMaxSplits halvings. A cell running into the shoulder reach limit is
+ * bisected for the last reachable coordinate first.
+ * @param arc Reachable arc from reachableArcs()
+ */
+void AnalyticalIK::solveArc(const Pose &targetPose,
+                            const Eigen::Vector3d &crossing,
+                            const Matrix3d &R, const Arc &arc,
+                            IKSolutions &result) const noexcept {
+  // The whole circle is periodic, a partial arc includes both ends and gets
+  // cells in proportion to its length
+  size_t numCells = mNumSamples;
+  if (!arc.whole) {
+    const auto cells = static_cast<size_t>(
+        std::ceil(static_cast<double>(numCells) * arc.length / (2 * M_PI)));
+    numCells = std::min(numCells, std::max(kMinArcCells, cells));
+  }
+  const size_t numPoints = arc.whole ? 2 * numCells : 2 * numCells + 1;
+  const double spacing = 1.0 / numCells;
+  std::array<Residuals, 2 * mNumSamples + 1> grid;
+  for (size_t k = 0; k < numPoints; ++k) {
+    const double phi = arc.angle(0.5 * spacing * static_cast<double>(k));
+    grid[k] = residuals(crossing, R, std::cos(phi), std::sin(phi));
+  }
+
+  for (size_t branch = 0; branch < mNumArmBranches; ++branch) {
+    auto f = [&](double u) {
+      return residual(crossing, R, arc.angle(u), branch);
+    };
+    auto complete = [&](double u) {
+      completeSolution(targetPose, crossing, arc.angle(u), branch, result);
+    };
+    auto refine = [&](double a, double fa, double b, double fb) {
+      double root = a;
+      int side = 0;
+      for (int iteration = 0; iteration < 64; ++iteration) {
+        root = (fa * b - fb * a) / (fa - fb);
+        const double fRoot = f(root);
+        if (!std::isfinite(fRoot) || std::abs(fRoot) < 1E-14) {
+          break;
+        }
+        if (fRoot * fb > 0) {
+          b = root;
+          fb = fRoot;
+          fa *= side == -1 ? 0.5 : 1.0;
+          side = -1;
+        } else {
+          a = root;
+          fa = fRoot;
+          fb *= side == 1 ? 0.5 : 1.0;
+          side = 1;
+        }
+      }
+      complete(root);
+    };
+
+    // Depth first, at most one sibling waits per depth
+    std::array<Span, kMaxSplits + 2> pending;
+    for (size_t cell = 0; cell < numCells; ++cell) {
+      Span span = {spacing * static_cast<double>(cell),
+                   grid[2 * cell][branch],
+                   spacing * (static_cast<double>(cell) + 0.5),
+                   grid[2 * cell + 1][branch],
+                   spacing * static_cast<double>(cell + 1),
+                   grid[(2 * cell + 2) % numPoints][branch],
+                   0};
+      if (span.fa == 0) {
+        complete(span.a);
+      }
+      const bool beginReachable = std::isfinite(span.fa);
+      const bool endReachable = std::isfinite(span.fb);
+      if (!beginReachable && !endReachable) {
+        continue;
+      }
+      if (!beginReachable || !endReachable || !std::isfinite(span.fm)) {
+        // The shoulder reach limit lies inside this cell, search from the
+        // last reachable coordinate to the reachable end
+        const double edge = beginReachable ? span.a : span.b;
+        const double fEdge = beginReachable ? span.fa : span.fb;
+        double inside = std::isfinite(span.fm) ? span.m : edge;
+        double outside = std::isfinite(span.fm)
+                             ? (beginReachable ? span.b : span.a)
+                             : span.m;
+        for (int iteration = 0; iteration < 48; ++iteration) {
+          const double middle = 0.5 * (inside + outside);
+          (std::isfinite(f(middle)) ? inside : outside) = middle;
+        }
+        const double middle = 0.5 * (edge + inside);
+        span = beginReachable
+                   ? Span{edge, fEdge, middle, f(middle), inside, f(inside), 0}
+                   : Span{inside, f(inside), middle, f(middle), edge, fEdge,
+                          0};
+        if (!std::isfinite(span.fa) || !std::isfinite(span.fm) ||
+            !std::isfinite(span.fb)) {
+          continue;
+        }
+      }
+
+      size_t numPending = 0;
+      pending[numPending++] = span;
+      while (numPending > 0) {
+        const Span current = pending[--numPending];
+        if (current.fm == 0) {
+          complete(current.m);
+        }
+        // Parabola fm + slope t + curvature t^2 over t in [-1, 1], and its
+        // closest approach to zero
+        const double slope = 0.5 * (current.fb - current.fa);
+        const double curvature = 0.5 * (current.fa + current.fb) - current.fm;
+        const double sign = current.fm > 0 ? 1 : -1;
+        const double vertex = curvature != 0 ? -slope / (2 * curvature) : 2.0;
+        const bool vertexInside = sign * curvature > 0 && std::abs(vertex) <= 1;
+        const double closest =
+            vertexInside
+                ? sign * (current.fm - slope * slope / (4 * curvature))
+                : std::min({sign * current.fa, sign * current.fm,
+                            sign * current.fb});
+        const bool hidden = closest <= kHiddenMargin * std::abs(curvature);
+        if (hidden && vertexInside && current.depth == kMaxSplits) {
+          // Tangent root, completeSolution rejects a near miss
+          complete(current.m + vertex * 0.5 * (current.b - current.a));
+          continue;
+        }
+        for (int half = 0; half < 2; ++half) {
+          const double x = half ? current.m : current.a;
+          const double fx = half ? current.fm : current.fa;
+          const double y = half ? current.b : current.m;
+          const double fy = half ? current.fb : current.fm;
+          if (fx * fy < 0) {
+            refine(x, fx, y, fy);
+            continue;
+          }
+          if (!hidden || current.depth == kMaxSplits) {
+            continue;
+          }
+          const double middle = 0.5 * (x + y);
+          pending[numPending++] = {x,      fx, middle, f(middle),
+                                   y,      fy, current.depth + 1};
+        }
+      }
+    }
+    if (!arc.whole && grid[numPoints - 1][branch] == 0) {
+      complete(1);
+    }
+  }
+}
+
+/**
+ * @brief The solution of targetPose closest to reference
+ * @param targetPose Pose of the end effector
+ * @param reference Configuration to stay close to, e.g. the current one
+ * @param solution Output, unwrapped by whole turns toward reference
+ * @return false if targetPose has no solution
+ */
+bool AnalyticalIK::solveClosest(const Pose &targetPose,
+                                const JointAngles &reference,
+                                JointAngles &solution) const noexcept {
+  IKSolutions result;
+  solve(targetPose, result);
+  double bestDistance = std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < result.count; ++i) {
+    double distance = 0;
+    for (size_t j = 0; j < reference.size(); ++j) {
+      const double delta = wrapAngle(result.solutions[i][j] - reference[j]);
+      distance += delta * delta;
+    }
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      for (size_t j = 0; j < reference.size(); ++j) {
+        solution[j] =
+            reference[j] + wrapAngle(result.solutions[i][j] - reference[j]);
+      }
+    }
+  }
+  return result.count > 0;
+}
+}  // namespace a3c
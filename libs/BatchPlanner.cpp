@@ -0,0 +1,113 @@
+/**
+ * @file BatchPlanner.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Parallel batch planning implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/BatchPlanner.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <exception>
+
+namespace a3c {
+/**
+ * @brief Construct a new BatchPlanner object
+ *
+ * @param inOptions IK options used for every job
+ * @param numThreads Worker count, 0 means one per hardware thread
+ * @param inGoalTolerance Largest accepted distance of the last waypoint from
+ * the target position, metres
+ */
+BatchPlanner::BatchPlanner(const IKOptions &inOptions, size_t numThreads,
+                           double inGoalTolerance)
+    : options(inOptions), goalTolerance(inGoalTolerance), pool(numThreads) {}
+
+/**
+ * @brief Plan every job on the pool
+ * @param jobs Moves to plan
+ * @return std::vector<PlanResult> One result per job, in job order
+ */
+std::vector<PlanResult> BatchPlanner::plan(const PlanJobs &jobs) {
+  std::vector<PlanResult> results(jobs.size());
+  // Each task writes only its own slot, so no synchronization is needed
+  pool.parallelFor(jobs.size(), [&](size_t i) {
+    results[i] = planJob(jobs[i], options, goalTolerance, forwardKinematics);
+  });
+  return results;
+}
+
+/**
+ * @brief Plan one job, time it and classify the outcome
+ * @param job Move to plan
+ * @param options IK options of the solve
+ * @param goalTolerance Largest accepted distance of the last waypoint from
+ * the target position, metres. Its orientation must be within
+ * options.angularTolerance of the target's.
+ * @param fk Verifies the last waypoint
+ * @param cancelled Optional flag polled between IK steps
+ * @return PlanResult Trajectory, status and solve time
+ */
+PlanResult planJob(const PlanJob &job, const IKOptions &options,
+                   double goalTolerance, const ForwardKinematics &fk,
+                   const std::atomic<bool> *cancelled) noexcept {
+  const auto start = std::chrono::steady_clock::now();
+  PlanResult result;
+  // Sets status and time only, every path returns result itself so the
+  // trajectory is never copied
+  auto finish = [&](PlanStatus status) {
+    result.status = status;
+    result.solveSecs = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+  };
+  try {
+    const InverseKinematics ik(job.startAngles, options);
+    if (cancelled == nullptr) {
+      result.trajectory = ik.linearIK(job.currentPose, job.targetPose);
+    } else {
+      auto generator = ik.linearTrajectory(job.currentPose, job.targetPose);
+      result.trajectory.reserve(generator.sizeHint());
+      JointAngles waypoint;
+      while (!cancelled->load(std::memory_order_relaxed) &&
+             generator.next(waypoint)) {
+        result.trajectory.push_back(waypoint);
+      }
+      if (!generator.done()) {
+        finish(PlanStatus::kCancelled);
+        return result;
+      }
+    }
+  } catch (const std::exception &) {
+    result.trajectory.clear();
+    finish(PlanStatus::kFailed);
+    return result;
+  }
+  const JointAngles &last =
+      result.trajectory.empty() ? job.startAngles : result.trajectory.back();
+  for (const auto &ja : result.trajectory) {
+    for (double q : ja) {
+      if (!std::isfinite(q)) {
+        finish(PlanStatus::kNonFinite);
+        return result;
+      }
+    }
+  }
+  // linearIK tracks the orientation too, a success must also reach it
+  const Pose reached = fk.fk(last);
+  result.goalError = (reached.position - job.targetPose.position).norm();
+  const double angleError =
+      orientationError(reached.orientation, job.targetPose.orientation)
+          .norm();
+  finish(result.goalError <= goalTolerance &&
+                 angleError <= options.angularTolerance
+             ? PlanStatus::kSuccess
+             : PlanStatus::kGoalNotReached);
+  return result;
+}
+}  // namespace a3c
@@ -13,34 +13,155 @@
 #include <iostream>
 
 #include "include/ForwardKinematics.hpp"
+#include "include/Instrumentation.hpp"
 
 namespace a3c {
+namespace {
+using FK = ForwardKinematics;
+/**
+ * @brief Modified DH transform of one joint in Scalar precision
+ * @note alpha, a and d are rounded to Scalar after the trig, as in fkBatch
+ */
+template <typename Scalar>
+Eigen::Matrix<Scalar, 4, 4> transformationMatrix(Scalar theta, double alpha,
+                                                 double a,
+                                                 double d) noexcept {
+  using std::cos;
+  using std::sin;
+  const Scalar sinTheta = sin(theta);
+  const Scalar cosTheta = cos(theta);
+  const Scalar sinAlpha = Scalar(sin(alpha));
+  const Scalar cosAlpha = Scalar(cos(alpha));
+  const Scalar dS = Scalar(d);
+  Eigen::Matrix<Scalar, 4, 4> T;
+  (T << cosTheta, -sinTheta, 0, Scalar(a), sinTheta * cosAlpha,
+   cosTheta * cosAlpha, -sinAlpha, -sinAlpha * dS, sinTheta * sinAlpha,
+   cosTheta * sinAlpha, cosAlpha, cosAlpha * dS, 0, 0, 0,
+   1);  // cppcheck-suppress constStatement
+  return T;
+}
+/**
+ * @brief Transform of joint i at jointAngle, the table is never written
+ */
+template <typename Scalar>
+Eigen::Matrix<Scalar, 4, 4> jointTransform(const FK::DHTable &dhTable,
+                                           size_t i,
+                                           Scalar jointAngle) noexcept {
+  return transformationMatrix<Scalar>(
+      Scalar(dhTable(i, FK::thetaIndex)) + jointAngle,
+      dhTable(i, FK::alphaIndex), dhTable(i, FK::aIndex),
+      dhTable(i, FK::dIndex));
+}
+/**
+ * @brief FK walk of the DH chain in Scalar precision
+ */
+template <typename Scalar>
+BasicPose<Scalar> chainFk(
+    const FK::DHTable &dhTable,
+    const BasicJointAngles<Scalar> &jointAngles) noexcept {
+  Eigen::Matrix<Scalar, 4, 4> T = Eigen::Matrix<Scalar, 4, 4>::Identity();
+  for (size_t i = 0; i < FK::mNumDHRows; ++i) {
+    T *= jointTransform(dhTable, i, jointAngles[i]);
+  }
+  return BasicPose<Scalar>(T);
+}
+/**
+ * @brief FK and geometric Jacobian in Scalar precision
+ * @note The table uses modified DH, so joint i turns about the z axis of frame
+ * i. Each joint's axis and origin are read off the running transform while
+ * walking the chain, then column i of the Jacobian is
+ * [z_i x (p_end - p_i); z_i].
+ */
+template <typename Scalar>
+BasicPose<Scalar> chainFkWithJacobian(
+    const FK::DHTable &dhTable, const BasicJointAngles<Scalar> &jointAngles,
+    BasicJacobian<Scalar> &jacobian) noexcept {
+  Eigen::Matrix<Scalar, 4, 4> T = Eigen::Matrix<Scalar, 4, 4>::Identity();
+  Eigen::Matrix<Scalar, 3, FK::mNumDHRows> origins;
+  for (size_t i = 0; i < FK::mNumDHRows; ++i) {
+    T *= jointTransform(dhTable, i, jointAngles[i]);
+    origins.col(i) = T.template block<3, 1>(0, 3);
+    jacobian.template block<3, 1>(3, i) = T.template block<3, 1>(0, 2);
+  }
+  const Eigen::Matrix<Scalar, 3, 1> endEffector = T.template block<3, 1>(0, 3);
+  for (size_t i = 0; i < FK::mNumDHRows; ++i) {
+    jacobian.template block<3, 1>(0, i) =
+        jacobian.template block<3, 1>(3, i).cross(endEffector - origins.col(i));
+  }
+  return BasicPose<Scalar>(T);
+}
+}  // namespace
+
 /**
  * @brief Construct a new Forward Kinematics:: Forward Kinematics object
  *
  */
-ForwardKinematics::ForwardKinematics() noexcept {
-  /*
-  initialize DH table in this constructor
-  */
-  (dhTable << 0, 0, dhParams.d1, 0, -M_PI_2, 0, dhParams.d2, -M_PI_2, 0,
-   dhParams.a2, -dhParams.d3, M_PI_2, M_PI_2, 0, dhParams.d4, 0, -M_PI_2, 0,
-   dhParams.d5, 0, M_PI_2, 0, dhParams.d6, M_PI_2)
-      .finished();
-}
+ForwardKinematics::ForwardKinematics() noexcept
+    : dhTable(makeDHTable<A3CDescription>()) {}
+/**
+ * @brief Construct a new Forward Kinematics object for another arm
+ *
+ * @param inDHTable alpha, a, d, theta offset of every joint, modified DH
+ */
+ForwardKinematics::ForwardKinematics(const DHTable &inDHTable) noexcept
+    : dhTable(inDHTable) {}
 /**
  * @brief Create fk Pose method
+ * @note The joint angle is added to a copy of the DH row, the table itself is
+ * never written, so concurrent calls on one instance are safe.
  * @param jointAngles Joint angles in radians
  * @return Pose: Pose of the End Effector
  */
-Pose ForwardKinematics::fk(const JointAngles &jointAngles) noexcept {
-  Matrix4d T = Matrix4d::Identity();
-  for (size_t i = 0; i < mNumDHRows; ++i) {
-    dhTable(i, thetaIndex) += jointAngles.at(i);
-    T *= getTransformationMatrix(dhTable.row(i));
-    dhTable(i, thetaIndex) -= jointAngles.at(i);
+Pose ForwardKinematics::fk(const JointAngles &jointAngles) const noexcept {
+  A3C_PROBE(kFk);
+  return chainFk(dhTable, jointAngles);
+}
+/**
+ * @brief Single precision fk
+ * @note Positions stay within 0.1 mm of the double version over the A3C
+ * workspace
+ * @param jointAngles Joint angles in radians
+ * @return PoseF: Pose of the End Effector
+ */
+PoseF ForwardKinematics::fk(const JointAnglesF &jointAngles) const noexcept {
+  A3C_PROBE(kFk);
+  return chainFk(dhTable, jointAngles);
+}
+/**
+ * @brief FK and geometric Jacobian in one pass
+ * @param jointAngles Joint angles in radians
+ * @param jacobian Output, 6x6 geometric Jacobian in the base frame
+ * @return Pose: Pose of the End Effector
+ */
+Pose ForwardKinematics::fkWithJacobian(const JointAngles &jointAngles,
+                                       Jacobian &jacobian) const noexcept {
+  A3C_PROBE(kFkWithJacobian);
+  return chainFkWithJacobian(dhTable, jointAngles, jacobian);
+}
+/**
+ * @brief Single precision FK and geometric Jacobian in one pass
+ * @param jointAngles Joint angles in radians
+ * @param jacobian Output, 6x6 geometric Jacobian in the base frame
+ * @return PoseF: Pose of the End Effector
+ */
+PoseF ForwardKinematics::fkWithJacobian(const JointAnglesF &jointAngles,
+                                        JacobianF &jacobian) const noexcept {
+  A3C_PROBE(kFkWithJacobian);
+  return chainFkWithJacobian(dhTable, jointAngles, jacobian);
+}
+/**
+ * @brief 64 bit FNV-1a hash of the DH table
+ * @note Files built from FK (seed indices, trajectories) store it and refuse
+ * to load against a different arm
+ * @return uint64_t Hash of the table bytes
+ */
+uint64_t ForwardKinematics::dhHash() const noexcept {
+  uint64_t hash = 14695981039346656037ULL;
+  const auto *bytes = reinterpret_cast<const unsigned char *>(dhTable.data());
+  for (size_t i = 0; i < sizeof(double) * dhTable.size(); ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
   }
-  return Pose(T);
+  return hash;
 }
 /**
  * @brief Gets Transformation Matrix
@@ -50,31 +171,9 @@ Pose ForwardKinematics::fk(const JointAngles &jointAngles) noexcept {
  */
 Matrix4d ForwardKinematics::getTransformationMatrix(
     const Eigen::Array<double, 1, mNumDHCols> &dhRow) const noexcept {
-  double sinTheta = sin(dhRow(thetaIndex));
-  double cosTheta = cos(dhRow(thetaIndex));
-  double sinAlpha = sin(dhRow(alphaIndex));
-  double cosAlpha = cos(dhRow(alphaIndex));
-  Matrix4d T;
-  (T << cosTheta, -sinTheta, 0, dhRow(aIndex), sinTheta * cosAlpha,
-   cosTheta * cosAlpha, -sinAlpha, -sinAlpha * dhRow(dIndex),
-   sinTheta * sinAlpha, cosTheta * sinAlpha, cosAlpha, cosAlpha * dhRow(dIndex),
-   0, 0, 0, 1);  // cppcheck-suppress constStatement
-  return T;
+  return transformationMatrix<double>(dhRow(thetaIndex), dhRow(alphaIndex),
+                                      dhRow(aIndex), dhRow(dIndex));
 }
-/**
- * @brief Construct a new DHParams::DHParams object
- *
- * @param d1
- * @param d2
- * @param d3
- * @param d4
- * @param d5
- * @param d6
- * @param a2
- */
-DHParams::DHParams(float d1, float d2, float d3, float d4, float d5, float d6,
-                   float a2)
-    : d1(d1), d2(d2), d3(d3), d4(d4), d5(d5), d6(d6), a2(a2) {}
 
 /**
  * @brief Override ostream
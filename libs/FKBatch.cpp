@@ -0,0 +1,146 @@
+/**
+ * @file FKBatch.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Batched, lane vectorized forward kinematics
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <cmath>
+
+#include "include/ForwardKinematics.hpp"
+#include "include/SimdMath.hpp"
+
+namespace a3c {
+namespace {
+/**
+ * @brief Quaternion of lane rotation matrices, same branch choice as
+ * Eigen::Quaterniond(Matrix3d) so fkBatch and fk agree on the sign
+ */
+template <typename Lanes>
+void lanesToQuaternion(const Lanes (&R)[3][4], Lanes &qx, Lanes &qy, Lanes &qz,
+                       Lanes &qw) noexcept {
+  using Scalar = typename Lanes::Scalar;
+  const Lanes trace = R[0][0] + R[1][1] + R[2][2];
+  auto safeSqrt = [](const Lanes &v) { return v.max(Scalar(0)).sqrt(); };
+
+  // Candidate with w as the pivot
+  const Lanes tw = safeSqrt(trace + Scalar(1));
+  const Lanes sw = Scalar(0.5) / tw;
+  // Candidates with x, y or z as the pivot
+  const Lanes tx = safeSqrt(R[0][0] - R[1][1] - R[2][2] + Scalar(1));
+  const Lanes sx = Scalar(0.5) / tx;
+  const Lanes ty = safeSqrt(R[1][1] - R[2][2] - R[0][0] + Scalar(1));
+  const Lanes sy = Scalar(0.5) / ty;
+  const Lanes tz = safeSqrt(R[2][2] - R[0][0] - R[1][1] + Scalar(1));
+  const Lanes sz = Scalar(0.5) / tz;
+
+  const auto useW = trace > Scalar(0);
+  const auto useY = (R[1][1] > R[0][0]) && (R[1][1] >= R[2][2]);
+  const auto useZ = (R[2][2] > R[0][0]) && (R[2][2] > R[1][1]);
+
+  qw = useW.select(Scalar(0.5) * tw,
+                   useZ.select((R[1][0] - R[0][1]) * sz,
+                               useY.select((R[0][2] - R[2][0]) * sy,
+                                           (R[2][1] - R[1][2]) * sx)));
+  qx = useW.select((R[2][1] - R[1][2]) * sw,
+                   useZ.select((R[0][2] + R[2][0]) * sz,
+                               useY.select((R[0][1] + R[1][0]) * sy,
+                                           Scalar(0.5) * tx)));
+  qy = useW.select((R[0][2] - R[2][0]) * sw,
+                   useZ.select((R[1][2] + R[2][1]) * sz,
+                               useY.select(Scalar(0.5) * ty,
+                                           (R[1][0] + R[0][1]) * sx)));
+  qz = useW.select((R[1][0] - R[0][1]) * sw,
+                   useZ.select(Scalar(0.5) * tz,
+                               useY.select((R[2][1] + R[1][2]) * sy,
+                                           (R[2][0] + R[0][2]) * sx)));
+}
+
+/**
+ * @brief FK of many joint configurations in Scalar precision
+ * @note Each block of NumLanes samples is pushed through the DH chain
+ * together: every entry of the running 3x4 transform is a lane array, so the
+ * trig and the chain products run on SIMD packets instead of one scalar 4x4
+ * product per sample. The DH constants are rounded to Scalar once per row.
+ */
+template <typename Scalar, int NumLanes>
+void fkBatchLanes(const ForwardKinematics::DHTable &dhTable,
+                  const BasicJointAnglesBatch<Scalar> &jointAngles,
+                  BasicPoseBatch<Scalar> &poses) noexcept {
+  using Lanes = Eigen::Array<Scalar, NumLanes, 1>;
+  using FK = ForwardKinematics;
+  constexpr Eigen::Index lanes = NumLanes;
+  const Eigen::Index count = jointAngles.rows();
+  poses.positions.resize(count, 3);
+  poses.orientations.resize(count, 4);
+
+  for (Eigen::Index begin = 0; begin < count; begin += lanes) {
+    const Eigen::Index valid = std::min(lanes, count - begin);
+    // Running transform, rows 0..2 of the homogeneous matrix
+    Lanes T[3][4];
+    for (int r = 0; r < 3; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        T[r][c].setConstant(r == c ? Scalar(1) : Scalar(0));
+      }
+    }
+    for (size_t i = 0; i < FK::mNumDHRows; ++i) {
+      Lanes theta = Lanes::Constant(Scalar(dhTable(i, FK::thetaIndex)));
+      theta.head(valid) += jointAngles.col(i).segment(begin, valid).array();
+      Lanes sinTheta;
+      Lanes cosTheta;
+      sinCos(theta, sinTheta, cosTheta);
+      const Scalar sinAlpha = Scalar(std::sin(dhTable(i, FK::alphaIndex)));
+      const Scalar cosAlpha = Scalar(std::cos(dhTable(i, FK::alphaIndex)));
+      const Scalar a = Scalar(dhTable(i, FK::aIndex));
+      const Scalar d = Scalar(dhTable(i, FK::dIndex));
+      // T *= getTransformationMatrix(row i), expanded per entry
+      for (int r = 0; r < 3; ++r) {
+        const Lanes u = cosAlpha * T[r][1] + sinAlpha * T[r][2];
+        const Lanes col0 = cosTheta * T[r][0] + sinTheta * u;
+        const Lanes col1 = cosTheta * u - sinTheta * T[r][0];
+        const Lanes col2 = cosAlpha * T[r][2] - sinAlpha * T[r][1];
+        T[r][3] += a * T[r][0] + d * col2;
+        T[r][0] = col0;
+        T[r][1] = col1;
+        T[r][2] = col2;
+      }
+    }
+    Lanes qx, qy, qz, qw;
+    lanesToQuaternion(T, qx, qy, qz, qw);
+    for (int r = 0; r < 3; ++r) {
+      poses.positions.col(r).segment(begin, valid) = T[r][3].head(valid);
+    }
+    poses.orientations.col(0).segment(begin, valid) = qx.head(valid);
+    poses.orientations.col(1).segment(begin, valid) = qy.head(valid);
+    poses.orientations.col(2).segment(begin, valid) = qz.head(valid);
+    poses.orientations.col(3).segment(begin, valid) = qw.head(valid);
+  }
+}
+}  // namespace
+
+/**
+ * @brief FK of many joint configurations
+ * @param jointAngles One configuration per row, in radians
+ * @param poses Output, resized to jointAngles.rows()
+ */
+void ForwardKinematics::fkBatch(const JointAnglesBatch &jointAngles,
+                                PoseBatch &poses) const noexcept {
+  fkBatchLanes<double, mBatchLanes>(dhTable, jointAngles, poses);
+}
+
+/**
+ * @brief Single precision FK of many joint configurations
+ * @note Twice the lanes of the double version per packet; positions stay
+ * within 0.1 mm of it over the A3C workspace
+ * @param jointAngles One configuration per row, in radians
+ * @param poses Output, resized to jointAngles.rows()
+ */
+void ForwardKinematics::fkBatch(const JointAnglesBatchF &jointAngles,
+                                PoseBatchF &poses) const noexcept {
+  fkBatchLanes<float, mFloatBatchLanes>(dhTable, jointAngles, poses);
+}
+}  // namespace a3c
@@ -14,17 +14,19 @@
 #include <iostream>
 
 #include "include/ForwardKinematics.hpp"
+#include "include/Instrumentation.hpp"
 #include "include/InverseKinematics.hpp"
 
 namespace a3c {
 /**
  * @brief Construct a new Inverse Kinematics:: Inverse Kinematics object
  *
- * @param FM
+ * @param inInitialJointAngles Joint angles every solve starts from
+ * @param inOptions Solver backend and its tuning
  */
-InverseKinematics::InverseKinematics(
-    const JointAngles& inInitialJointAngles) noexcept
-    : deltaTimeSecs(0.001) {
+InverseKinematics::InverseKinematics(const JointAngles& inInitialJointAngles,
+                                     const IKOptions& inOptions) noexcept
+    : deltaTimeSecs(0.001), options(inOptions) {
   this->initialJointAngles = inInitialJointAngles;
 }
 
@@ -32,196 +34,171 @@ InverseKinematics::InverseKinematics(
  * @brief Solve for Inverse Kinematics
  * @note This function takes in currentPose, targetPose and gives a vector of
  * jointAngles which result in a linear translation between currentPose and
- * TargetPose
- * @param currentAngles
- * @param targetAngles
+ * TargetPose. With IKIntegration::kFixedStep there is one waypoint per
+ * deltaTimeSecs, with kAdaptive one per accepted error controlled step.
+ * @param currentPose
+ * @param targetPose
  * @return std::vector <JointAngles>
  */
-std::vector<JointAngles> InverseKinematics::linearIK(const Pose& currentPose,
-                                                     const Pose& targetPose) {
+std::vector<JointAngles> InverseKinematics::linearIK(
+    const Pose& currentPose, const Pose& targetPose) const {
+  A3C_PROBE(kLinearIK);
+  auto generator = linearTrajectory(currentPose, targetPose);
   std::vector<JointAngles> jointTrajectory;
-  auto phi = 0.0;
-  auto dPhi_dt = 1;
-  auto currentPosition = currentPose.position;
-  auto targetPosition = targetPose.position;
-  auto currentAngles = initialJointAngles;
-  auto getJointAnglesFromVector = [](const auto& vec) {
-    JointAngles ja = {vec[0], vec[1], vec[2], vec[3], vec[4], vec[5]};
-    return ja;
-  };
-  auto oldPosition = currentPosition;
-  for (;;) {
-    if (phi >= 1) {
-      break;
-    }
-    auto newPosition = ((1 - phi) * currentPosition) + (phi * targetPosition);
-    auto dPos_dt = (newPosition - oldPosition) / deltaTimeSecs;
-    VectorXd dpos_dt_vec(6);
-    for (int i = 0; i < 3; i++) {
-      dpos_dt_vec[i] = dPos_dt[i];
-    }
-    for (int i = 3; i < 6; i++) {
-      dpos_dt_vec[i] = 0;
-    }
-    auto joint_vels = getJacobian(currentAngles)
-                          .completeOrthogonalDecomposition()
-                          .pseudoInverse() *
-                      dpos_dt_vec;
-    JointAngles newJA;
-    auto jointvel_into_delta_t =
-        getJointAnglesFromVector(joint_vels * deltaTimeSecs);
-    for (int i = 0; i < 6; i++) {
-      newJA[i] = currentAngles[i] + jointvel_into_delta_t[i];
-    }
-    jointTrajectory.push_back(newJA);
-    currentAngles = newJA;
-    phi += dPhi_dt * deltaTimeSecs;
-    oldPosition = newPosition;
+  jointTrajectory.reserve(generator.sizeHint());
+  A3C_COUNT(kAllocations, 1);
+  for (const auto& ja : generator) {
+    A3C_COUNT(kVectorGrowth,
+              jointTrajectory.size() == jointTrajectory.capacity());
+    jointTrajectory.push_back(ja);
   }
-  jointTrajectory.shrink_to_fit();
   return jointTrajectory;
 }
 
 /**
- @brief Get Jacobian Matrix for the given joint angles
- @note This function takes in jointAngles and returns a 6x6 Jacobian Matrix
- @param jointAngles 6 joint angles of the robot
- @return MatrixXd 6x6 Jacobian Matrix
-*/
-MatrixXd InverseKinematics::getJacobian(const JointAngles& jointAngles) {
-  const auto jacobianSize = 6;
-  MatrixXd J(jacobianSize, jacobianSize);
-  auto theta1 = jointAngles.at(0);
-  auto theta2 = jointAngles.at(1);
-  auto theta3 = jointAngles.at(2);
-  auto theta4 = jointAngles.at(3);
-  auto theta5 = jointAngles.at(4);
-  J.row(0) << -0.23000000000000001 * sin(theta1) * sin(theta2) +
-                  0.16350000000000001 * sin(theta1) * sin(theta4) *
-                      cos(theta2 + theta3) -
-                  0.16600000000000001 * sin(theta1) * sin(theta5) *
-                      cos(theta4) * cos(theta2 + theta3) -
-                  0.16600000000000001 * sin(theta1) * sin(theta2 + theta3) *
-                      cos(theta5) -
-                  0.23000000000000001 * sin(theta1) * sin(theta2 + theta3) -
-                  0.16600000000000001 * sin(theta4) * sin(theta5) *
-                      cos(theta1) -
-                  0.16350000000000001 * cos(theta1) * cos(theta4) +
-                  0.00050000000000000001 * cos(theta1),
-      0.16350000000000001 * sin(theta4) * sin(theta2 + theta3) * cos(theta1) -
-          0.16600000000000001 * sin(theta5) * sin(theta2 + theta3) *
-              cos(theta1) * cos(theta4) +
-          0.23000000000000001 * cos(theta1) * cos(theta2) +
-          0.16600000000000001 * cos(theta1) * cos(theta5) *
-              cos(theta2 + theta3) +
-          0.23000000000000001 * cos(theta1) * cos(theta2 + theta3),
-      0.16350000000000001 * sin(theta4) * sin(theta2 + theta3) * cos(theta1) -
-          0.16600000000000001 * sin(theta5) * sin(theta2 + theta3) *
-              cos(theta1) * cos(theta4) +
-          0.16600000000000001 * cos(theta1) * cos(theta5) *
-              cos(theta2 + theta3) +
-          0.23000000000000001 * cos(theta1) * cos(theta2 + theta3),
-      0.16350000000000001 * sin(theta1) * sin(theta4) -
-          0.16600000000000001 * sin(theta1) * sin(theta5) * cos(theta4) -
-          0.16600000000000001 * sin(theta4) * sin(theta5) * cos(theta1) *
-              cos(theta2 + theta3) -
-          0.16350000000000001 * cos(theta1) * cos(theta4) *
-              cos(theta2 + theta3),
-      -0.16600000000000001 * sin(theta1) * sin(theta4) * cos(theta5) -
-          0.16600000000000001 * sin(theta5) * sin(theta2 + theta3) *
-              cos(theta1) +
-          0.16600000000000001 * cos(theta1) * cos(theta4) * cos(theta5) *
-              cos(theta2 + theta3),  // cppcheck-suppress constStatement
-      0;
-
-  J.row(1) << -0.16600000000000001 * sin(theta1) * sin(theta4) * sin(theta5) -
-                  0.16350000000000001 * sin(theta1) * cos(theta4) +
-                  0.00050000000000000001 * sin(theta1) +
-                  0.23000000000000001 * sin(theta2) * cos(theta1) -
-                  0.16350000000000001 * sin(theta4) * cos(theta1) *
-                      cos(theta2 + theta3) +
-                  0.16600000000000001 * sin(theta5) * cos(theta1) *
-                      cos(theta4) * cos(theta2 + theta3) +
-                  0.16600000000000001 * sin(theta2 + theta3) * cos(theta1) *
-                      cos(theta5) +
-                  0.23000000000000001 * sin(theta2 + theta3) * cos(theta1),
-      0.16350000000000001 * sin(theta1) * sin(theta4) * sin(theta2 + theta3) -
-          0.16600000000000001 * sin(theta1) * sin(theta5) *
-              sin(theta2 + theta3) * cos(theta4) +
-          0.23000000000000001 * sin(theta1) * cos(theta2) +
-          0.16600000000000001 * sin(theta1) * cos(theta5) *
-              cos(theta2 + theta3) +
-          0.23000000000000001 * sin(theta1) * cos(theta2 + theta3),
-      0.16350000000000001 * sin(theta1) * sin(theta4) * sin(theta2 + theta3) -
-          0.16600000000000001 * sin(theta1) * sin(theta5) *
-              sin(theta2 + theta3) * cos(theta4) +
-          0.16600000000000001 * sin(theta1) * cos(theta5) *
-              cos(theta2 + theta3) +
-          0.23000000000000001 * sin(theta1) * cos(theta2 + theta3),
-      -0.16600000000000001 * sin(theta1) * sin(theta4) * sin(theta5) *
-              cos(theta2 + theta3) -
-          0.16350000000000001 * sin(theta1) * cos(theta4) *
-              cos(theta2 + theta3) -
-          0.16350000000000001 * sin(theta4) * cos(theta1) +
-          0.16600000000000001 * sin(theta5) * cos(theta1) * cos(theta4),
-      -0.16600000000000001 * sin(theta1) * sin(theta5) * sin(theta2 + theta3) +
-          0.16600000000000001 * sin(theta1) * cos(theta4) * cos(theta5) *
-              cos(theta2 + theta3) +
-          0.16600000000000001 * sin(theta4) * cos(theta1) *
-              cos(theta5),  // cppcheck-suppress constStatement
-      0;
+ * @brief Start a lazily evaluated linearIK move
+ * @param currentPose Pose of the initial joint angles
+ * @param targetPose Pose to reach in a straight line
+ * @return TrajectoryGenerator Yields the waypoints of linearIK on demand
+ */
+TrajectoryGenerator InverseKinematics::linearTrajectory(
+    const Pose& currentPose, const Pose& targetPose) const noexcept {
+  return TrajectoryGenerator(*this, currentPose, targetPose);
+}
 
-  J.row(2) << 0,
-      -0.23000000000000001 * sin(theta2) +
-          0.16350000000000001 * sin(theta4) * cos(theta2 + theta3) -
-          0.16600000000000001 * sin(theta5) * cos(theta4) *
-              cos(theta2 + theta3) -
-          0.16600000000000001 * sin(theta2 + theta3) * cos(theta5) -
-          0.23000000000000001 * sin(theta2 + theta3),
-      0.16350000000000001 * sin(theta4) * cos(theta2 + theta3) -
-          0.16600000000000001 * sin(theta5) * cos(theta4) *
-              cos(theta2 + theta3) -
-          0.16600000000000001 * sin(theta2 + theta3) * cos(theta5) -
-          0.23000000000000001 * sin(theta2 + theta3),
-      0.16600000000000001 * sin(theta4) * sin(theta5) * sin(theta2 + theta3) +
-          0.16350000000000001 * sin(theta2 + theta3) * cos(theta4),
-      -0.16600000000000001 * sin(theta5) * cos(theta2 + theta3) -
-          0.16600000000000001 * sin(theta2 + theta3) * cos(theta4) *
-              cos(theta5),  // cppcheck-suppress constStatement
-      0;
+/**
+ * @brief Compute one joint increment toward a Cartesian set-point
+ * @note Pose feedback and the Jacobian of currentAngles come from one FK pass,
+ * the increment heads for targetPose from where the arm actually is, so
+ * integration error does not accumulate. The twist is the full 6-vector,
+ * position error on top of the orientation error, so a step tracks
+ * targetPose.orientation as well. All buffers
+ * live in workspace, the call makes no heap allocation, which keeps its
+ * latency bounded on a real time control thread.
+ * @param currentAngles Joint angles the arm is at
+ * @param targetPose Set-point for the end of this step, e.g. the next point of
+ * a path, not a far away goal
+ * @param workspace Caller owned buffers, reused between calls
+ * @param nextAngles Output, currentAngles plus the joint increment
+ * @return double Position error in metres before the step
+ */
+double InverseKinematics::step(const JointAngles& currentAngles,
+                               const Pose& targetPose, IKWorkspace& workspace,
+                               JointAngles& nextAngles) const noexcept {
+  auto actualPose =
+      forwardKinematics.fkWithJacobian(currentAngles, workspace.jacobian);
+  return stepFrom(currentAngles, actualPose, targetPose, workspace,
+                  nextAngles);
+}
 
-  J.row(3) << 0, -sin(theta1), -sin(theta1),
-      sin(theta2) * cos(theta1) * cos(theta3) +
-          sin(theta3) * cos(theta1) * cos(theta2),
-      -(-sin(theta2) * sin(theta3) * cos(theta1) +
-        cos(theta1) * cos(theta2) * cos(theta3)) *
-              sin(theta4) -
-          sin(theta1) * cos(theta4),  // cppcheck-suppress constStatement
-      -(sin(theta1) * sin(theta4) -
-        cos(theta1) * cos(theta4) * cos(theta2 + theta3)) *
-              sin(theta5) +
-          sin(theta2 + theta3) * cos(theta1) * cos(theta5);
+/**
+ * @brief Joint increment from an FK pass that is already in workspace
+ * @param currentAngles Joint angles the arm is at
+ * @param actualPose Pose of currentAngles, workspace.jacobian its Jacobian
+ * @param targetPose Set-point for the end of this step
+ * @param workspace Caller owned buffers, reused between calls
+ * @param nextAngles Output, currentAngles plus the joint increment
+ * @return double Position error in metres before the step
+ */
+double InverseKinematics::stepFrom(const JointAngles& currentAngles,
+                                   const Pose& actualPose,
+                                   const Pose& targetPose,
+                                   IKWorkspace& workspace,
+                                   JointAngles& nextAngles) const noexcept {
+  A3C_COUNT(kSteps, 1);
+  workspace.twist.head<3>() = targetPose.position - actualPose.position;
+  workspace.twist.tail<3>() =
+      orientationError(actualPose.orientation, targetPose.orientation);
+  solveVelocityStep(workspace);
+  for (size_t i = 0; i < nextAngles.size(); i++) {
+    nextAngles[i] = currentAngles[i] + workspace.jointDelta[i];
+  }
+  return workspace.twist.head<3>().norm();
+}
 
-  J.row(4) << 0, cos(theta1), cos(theta1),
-      sin(theta1) * sin(theta2) * cos(theta3) +
-          sin(theta1) * sin(theta3) * cos(theta2),
-      -(-sin(theta1) * sin(theta2) * sin(theta3) +
-        sin(theta1) * cos(theta2) * cos(theta3)) *
-              sin(theta4) +
-          cos(theta1) * cos(theta4),  // cppcheck-suppress constStatement
-      (sin(theta1) * cos(theta4) * cos(theta2 + theta3) +
-       sin(theta4) * cos(theta1)) *
-              sin(theta5) +
-          sin(theta1) * sin(theta2 + theta3) * cos(theta5);
+/**
+ * @brief Orientation error as a rotation vector
+ * @note The Jacobian's angular rows are joint axes in the base frame, so the
+ * error rotation is target * actual^-1. Its quaternion is taken with w >= 0,
+ * the short way round, and mapped to axis * angle without going through a
+ * rotation matrix.
+ * @param actual Orientation the arm is at
+ * @param target Orientation to reach
+ * @return Eigen::Vector3d Axis times angle in radians, base frame
+ */
+Eigen::Vector3d orientationError(const Eigen::Quaterniond& actual,
+                                 const Eigen::Quaterniond& target) noexcept {
+  Eigen::Quaterniond error = target * actual.conjugate();
+  if (error.w() < 0) {
+    error.coeffs() = -error.coeffs();
+  }
+  const double sinHalfAngle = error.vec().norm();
+  if (sinHalfAngle < 1E-12) {
+    return 2 * error.vec();
+  }
+  return (2 * std::atan2(sinHalfAngle, error.w()) / sinHalfAngle) *
+         error.vec();
+}
 
-  J.row(5) << 1, 0, 0, -sin(theta2) * sin(theta3) + cos(theta2) * cos(theta3),
-      -(-sin(theta2) * cos(theta3) - sin(theta3) * cos(theta2)) *
-          sin(theta4),  // cppcheck-suppress constStatement
-      -sin(theta5) * sin(theta2 + theta3) * cos(theta4) +
-          cos(theta5) * cos(theta2 + theta3);
-  for (int i = 0; i < jacobianSize; i++) {
-    assert(J.row(0).size() == jacobianSize);
+/**
+ * @brief Solve for the joint increment of one step
+ * @note Damped least squares solves (J J^T + lambda^2 I) y = twist with a
+ * fixed size LDLT and returns J^T y, no pseudoinverse is formed. The
+ * manipulability w = |det J| = sqrt(det(J J^T)) falls out of the same
+ * factorization. Below manipulabilityThreshold w0 the damping is
+ * lambda^2 = maxDamping^2 (1 - w / w0)^2 (Nakamura), so increments stay
+ * bounded near singularities and the solve is exact elsewhere.
+ * @param workspace Reads jacobian and twist, writes jointDelta
+ */
+void InverseKinematics::solveVelocityStep(IKWorkspace& workspace) const
+    noexcept {
+  A3C_PROBE(kVelocitySolve);
+  const auto& J = workspace.jacobian;
+  switch (options.solver) {
+    case IKSolver::kCompleteOrthogonal:
+      workspace.solver.compute(J);
+      // Pivoted QR diagonal, rank revealing estimate of the singular values
+      A3C_CONDITION(
+          workspace.solver.matrixQTZ().diagonal().cwiseAbs().maxCoeff() /
+          workspace.solver.matrixQTZ().diagonal().cwiseAbs().minCoeff());
+      workspace.jointDelta = workspace.solver.solve(workspace.twist);
+      return;
+    case IKSolver::kDampedLeastSquares:
+      break;
   }
+  workspace.normal.noalias() = J * J.transpose();
+  workspace.ldlt.compute(workspace.normal);
+  const double manipulability =
+      std::sqrt(std::max(0.0, workspace.ldlt.vectorD().prod()));
+  // D of the pivoted LDLT of J J^T estimates the squared singular values of J
+  A3C_CONDITION(std::sqrt(workspace.ldlt.vectorD().cwiseAbs().maxCoeff() /
+                          workspace.ldlt.vectorD().cwiseAbs().minCoeff()));
+  if (manipulability < options.manipulabilityThreshold) {
+    A3C_COUNT(kDampedSteps, 1);
+    const double closeness =
+        1 - manipulability / options.manipulabilityThreshold;
+    const double damping = options.maxDamping * closeness;
+    workspace.normal.diagonal().array() += damping * damping;
+    workspace.ldlt.compute(workspace.normal);
+  }
+  workspace.jointDelta.noalias() =
+      J.transpose() * workspace.ldlt.solve(workspace.twist);
+}
+
+/**
+ @brief Get Jacobian Matrix for the given joint angles
+ @note This function takes in jointAngles and returns a 6x6 Jacobian Matrix,
+ derived from the DH table of ForwardKinematics
+ @param jointAngles 6 joint angles of the robot
+ @return MatrixXd 6x6 Jacobian Matrix
+*/
+MatrixXd InverseKinematics::getJacobian(
+    const JointAngles& jointAngles) const {
+  A3C_PROBE(kGetJacobian);
+  // The MatrixXd return value is a heap allocation
+  A3C_COUNT(kAllocations, 1);
+  Jacobian J;
+  forwardKinematics.fkWithJacobian(jointAngles, J);
   return J;
-}  // namespace a3c
+}
 }  // namespace a3c
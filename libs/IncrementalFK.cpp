@@ -0,0 +1,91 @@
+/**
+ * @file IncrementalFK.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Incremental FK implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <cmath>
+
+#include "include/IncrementalForwardKinematics.hpp"
+
+namespace a3c {
+constexpr const size_t IncrementalForwardKinematics::mNumLinks;
+
+/**
+ * @brief Construct a new IncrementalForwardKinematics object
+ *
+ * @param fk Source of the DH table
+ */
+IncrementalForwardKinematics::IncrementalForwardKinematics(
+    const ForwardKinematics &fk) noexcept {
+  using FK = ForwardKinematics;
+  const auto &dh = fk.getDHTable();
+  for (size_t i = 0; i < mNumLinks; ++i) {
+    cosAlpha[i] = std::cos(dh(i, FK::alphaIndex));
+    sinAlpha[i] = std::sin(dh(i, FK::alphaIndex));
+    linkA[i] = dh(i, FK::aIndex);
+    linkD[i] = dh(i, FK::dIndex);
+    thetaOffset[i] = dh(i, FK::thetaIndex);
+  }
+  angles.fill(0);
+  for (size_t i = 0; i < mNumLinks; ++i) {
+    updateLink(i);
+  }
+}
+
+/**
+ * @brief Recompute the links from the first changed joint on
+ * @param jointAngles Joint angles in radians
+ * @return size_t First recomputed joint, mNumLinks if nothing changed
+ */
+size_t IncrementalForwardKinematics::update(
+    const JointAngles &jointAngles) noexcept {
+  size_t first = 0;
+  while (first < mNumLinks && jointAngles[first] == angles[first]) {
+    ++first;
+  }
+  for (size_t i = first; i < mNumLinks; ++i) {
+    angles[i] = jointAngles[i];
+    updateLink(i);
+  }
+  return first;
+}
+
+/**
+ * @brief Append link i to the frame of link i - 1
+ * @note frames[i] RotX(alpha) TransX(a) RotZ(theta) TransZ(d), modified DH,
+ * applied to the columns directly instead of multiplying 4x4 matrices
+ */
+void IncrementalForwardKinematics::updateLink(size_t i) noexcept {
+  const LinkFrame &parent = frames[i];
+  LinkFrame &link = frames[i + 1];
+  const double theta = angles[i] + thetaOffset[i];
+  const double cosTheta = std::cos(theta);
+  const double sinTheta = std::sin(theta);
+  const Eigen::Vector3d x = parent.rotation.col(0);
+  const Eigen::Vector3d y = cosAlpha[i] * parent.rotation.col(1) +
+                            sinAlpha[i] * parent.rotation.col(2);
+  const Eigen::Vector3d z = cosAlpha[i] * parent.rotation.col(2) -
+                            sinAlpha[i] * parent.rotation.col(1);
+  link.origin = parent.origin + linkA[i] * x + linkD[i] * z;
+  link.rotation.col(0) = cosTheta * x + sinTheta * y;
+  link.rotation.col(1) = cosTheta * y - sinTheta * x;
+  link.rotation.col(2) = z;
+}
+
+/**
+ * @brief Pose of the end effector
+ * @return Pose: Pose of the End Effector
+ */
+Pose IncrementalForwardKinematics::pose() const noexcept {
+  Matrix4d T = Matrix4d::Identity();
+  T.topLeftCorner<3, 3>() = frames[mNumLinks].rotation;
+  T.topRightCorner<3, 1>() = frames[mNumLinks].origin;
+  return Pose(T);
+}
+}  // namespace a3c
@@ -0,0 +1,181 @@
+/**
+ * @file Instrumentation.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Thread registry, snapshots and JSON export of the hot path counters
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/Instrumentation.hpp"
+
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace a3c {
+namespace instrumentation {
+thread_local ThreadCounters *tlsCounters = nullptr;
+
+namespace {
+/**
+ * @brief Blocks of every thread that ever ran a probe, never freed so a
+ * snapshot can read them after their thread exited
+ */
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadCounters>> threads;
+};
+
+Registry &registry() {
+  static Registry *instance = new Registry();
+  return *instance;
+}
+
+template <size_t N>
+void accumulate(const std::array<std::atomic<uint64_t>, N> &from,
+                std::array<uint64_t, N> *to) {
+  for (size_t i = 0; i < N; ++i) {
+    (*to)[i] += from[i].load(std::memory_order_relaxed);
+  }
+}
+
+template <size_t N>
+void zero(std::array<std::atomic<uint64_t>, N> *values) {
+  for (auto &value : *values) {
+    value.store(0, std::memory_order_relaxed);
+  }
+}
+
+template <size_t N>
+void writeArray(std::ostream &out, const std::array<uint64_t, N> &values) {
+  out << "[";
+  for (size_t i = 0; i < N; ++i) {
+    out << (i > 0 ? ", " : "") << values[i];
+  }
+  out << "]";
+}
+}  // namespace
+
+/**
+ * @brief Called once per thread, on its first probe
+ * @return ThreadCounters& Zeroed block owned by the registry
+ */
+ThreadCounters &registerThread() {
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  reg.threads.emplace_back(new ThreadCounters());
+  tlsCounters = reg.threads.back().get();
+  return *tlsCounters;
+}
+}  // namespace instrumentation
+
+constexpr size_t InstrumentationSnapshot::mNumProbes;
+constexpr size_t InstrumentationSnapshot::mNumCounters;
+constexpr size_t InstrumentationSnapshot::mNumConditionBuckets;
+
+/**
+ * @brief Sum the counters of every registered thread
+ * @note Threads keep counting while the snapshot is taken, so the totals are
+ * a consistent lower bound rather than an instant in time
+ * @return InstrumentationSnapshot Totals since start up or the last reset
+ */
+InstrumentationSnapshot instrumentationSnapshot() {
+  InstrumentationSnapshot snapshot;
+#ifdef A3C_INSTRUMENTATION
+  snapshot.enabled = true;
+#endif
+  auto &reg = instrumentation::registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for (const auto &thread : reg.threads) {
+    instrumentation::accumulate(thread->calls, &snapshot.calls);
+    instrumentation::accumulate(thread->cycles, &snapshot.cycles);
+    instrumentation::accumulate(thread->counters, &snapshot.counters);
+    instrumentation::accumulate(thread->conditionHistogram,
+                                &snapshot.conditionHistogram);
+  }
+  return snapshot;
+}
+
+void resetInstrumentation() {
+  auto &reg = instrumentation::registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for (const auto &thread : reg.threads) {
+    instrumentation::zero(&thread->calls);
+    instrumentation::zero(&thread->cycles);
+    instrumentation::zero(&thread->counters);
+    instrumentation::zero(&thread->conditionHistogram);
+  }
+}
+
+/**
+ * @brief Serialize a snapshot
+ * @note Probes map to {"calls", "cycles"}, counters to their value, the
+ * histogram is an array of decade counts starting at [1, 10)
+ * @param snapshot Totals to write
+ * @return std::string JSON object on one line
+ */
+std::string toJson(const InstrumentationSnapshot &snapshot) {
+  std::ostringstream out;
+  out << "{\"enabled\": " << (snapshot.enabled ? "true" : "false")
+      << ", \"probes\": {";
+  for (size_t i = 0; i < InstrumentationSnapshot::mNumProbes; ++i) {
+    out << (i > 0 ? ", " : "") << "\"" << probeName(static_cast<Probe>(i))
+        << "\": {\"calls\": " << snapshot.calls[i]
+        << ", \"cycles\": " << snapshot.cycles[i] << "}";
+  }
+  out << "}, \"counters\": {";
+  for (size_t i = 0; i < InstrumentationSnapshot::mNumCounters; ++i) {
+    out << (i > 0 ? ", " : "") << "\""
+        << counterName(static_cast<Counter>(i))
+        << "\": " << snapshot.counters[i];
+  }
+  out << "}, \"condition_histogram\": ";
+  instrumentation::writeArray(out, snapshot.conditionHistogram);
+  out << "}";
+  return out.str();
+}
+
+const char *probeName(Probe probe) noexcept {
+  switch (probe) {
+    case Probe::kFk:
+      return "fk";
+    case Probe::kFkWithJacobian:
+      return "fk_with_jacobian";
+    case Probe::kGetJacobian:
+      return "get_jacobian";
+    case Probe::kVelocitySolve:
+      return "velocity_solve";
+    case Probe::kLinearIK:
+      return "linear_ik";
+    case Probe::kCount:
+      break;
+  }
+  return "unknown";
+}
+
+const char *counterName(Counter counter) noexcept {
+  switch (counter) {
+    case Counter::kMoves:
+      return "moves";
+    case Counter::kSteps:
+      return "steps";
+    case Counter::kRejectedSteps:
+      return "rejected_steps";
+    case Counter::kToleranceViolations:
+      return "tolerance_violations";
+    case Counter::kDampedSteps:
+      return "damped_steps";
+    case Counter::kAllocations:
+      return "allocations";
+    case Counter::kVectorGrowth:
+      return "vector_growth";
+    case Counter::kCount:
+      break;
+  }
+  return "unknown";
+}
+}  // namespace a3c
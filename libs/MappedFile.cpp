@@ -0,0 +1,55 @@
+/**
+ * @file MappedFile.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief POSIX memory mapping
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace a3c {
+/**
+ * @brief Map a file read only
+ * @param path File to map
+ * @return true if the whole file is mapped
+ */
+bool MappedFile::open(const std::string &path) noexcept {
+  close();
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || status.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(status.st_size);
+  void *data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid after the descriptor is closed
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  mapping = data;
+  mappingSize = size;
+  return true;
+}
+
+void MappedFile::close() noexcept {
+  if (mapping != nullptr) {
+    ::munmap(mapping, mappingSize);
+  }
+  mapping = nullptr;
+  mappingSize = 0;
+}
+}  // namespace a3c
@@ -0,0 +1,146 @@
+/**
+ * @file PlanningService.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Asynchronous planning service implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/PlanningService.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace a3c {
+/**
+ * @brief Construct a new PlanningService object and start its workers
+ *
+ * @param inOptions IK options, worker count, queue capacity and tolerance
+ */
+PlanningService::PlanningService(const PlanningServiceOptions &inOptions)
+    : options(inOptions) {
+  size_t numThreads = options.numThreads;
+  if (numThreads == 0) {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (size_t i = 0; i < numThreads; ++i) {
+    workers.emplace_back(&PlanningService::workerLoop, this);
+  }
+}
+
+/**
+ * @brief Cancel outstanding requests and join the workers
+ * @note Queued requests still get their callback, with kCancelled
+ */
+PlanningService::~PlanningService() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+    for (const auto &flag : running) {
+      flag->store(true, std::memory_order_relaxed);
+    }
+  }
+  requestAvailable.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+/**
+ * @brief Queue a request whose result is delivered through a future
+ * @param job Move to plan
+ * @param priority Queue order
+ * @param ticket Output, future of the result and its cancel flag
+ * @return false if the queue is full or the service is stopping
+ */
+bool PlanningService::submit(const PlanJob &job, PlanPriority priority,
+                             PlanTicket &ticket) {
+  auto promise = std::make_shared<std::promise<PlanResult>>();
+  auto future = promise->get_future();
+  auto flag = submit(job, priority, [promise](PlanResult &&result) {
+    promise->set_value(std::move(result));
+  });
+  if (!flag) {
+    return false;
+  }
+  ticket.result = std::move(future);
+  ticket.cancelFlag = std::move(flag);
+  return true;
+}
+
+/**
+ * @brief Queue a request whose result is delivered to a callback
+ * @param job Move to plan
+ * @param priority Queue order
+ * @param callback Receives the result once, on a worker thread
+ * @return CancelFlag Flag that cancels the request, nullptr if the queue is
+ * full or the service is stopping
+ */
+CancelFlag PlanningService::submit(const PlanJob &job, PlanPriority priority,
+                                   PlanCallback callback) {
+  RequestPtr request(new Request{job, priority, 0,
+                                 std::make_shared<std::atomic<bool>>(false),
+                                 std::move(callback)});
+  CancelFlag flag = request->cancelFlag;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopping || requests.size() >= options.queueCapacity) {
+      return nullptr;
+    }
+    request->sequence = nextSequence++;
+    requests.push_back(std::move(request));
+    std::push_heap(requests.begin(), requests.end(), LaterFirst());
+  }
+  requestAvailable.notify_one();
+  return flag;
+}
+
+size_t PlanningService::queued() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return requests.size();
+}
+
+/**
+ * @brief Take the most urgent request, plan it and deliver the result
+ * @note On shutdown the remaining queue is drained as cancelled, so every
+ * accepted request gets exactly one result
+ */
+void PlanningService::workerLoop() {
+  for (;;) {
+    RequestPtr request;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      requestAvailable.wait(lock,
+                            [this] { return stopping || !requests.empty(); });
+      if (requests.empty()) {
+        return;
+      }
+      // pop_heap moves the most urgent request to the back, it leaves the heap
+      // before it is moved from
+      std::pop_heap(requests.begin(), requests.end(), LaterFirst());
+      request = std::move(requests.back());
+      requests.pop_back();
+      if (stopping) {
+        request->cancelFlag->store(true, std::memory_order_relaxed);
+      }
+      running.push_back(request->cancelFlag);
+    }
+    PlanResult result;
+    if (request->cancelFlag->load(std::memory_order_relaxed)) {
+      result.status = PlanStatus::kCancelled;
+    } else {
+      result = planJob(request->job, options.ikOptions, options.goalTolerance,
+                       forwardKinematics, request->cancelFlag.get());
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      running.erase(
+          std::find(running.begin(), running.end(), request->cancelFlag));
+    }
+    request->callback(std::move(result));
+  }
+}
+}  // namespace a3c
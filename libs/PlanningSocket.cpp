@@ -0,0 +1,444 @@
+/**
+ * @file PlanningSocket.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Unix domain socket planning server and client
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/PlanningSocket.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+
+namespace a3c {
+namespace {
+constexpr char kRequestMagic[4] = {'A', '3', 'C', 'Q'};
+constexpr char kResponseMagic[4] = {'A', '3', 'C', 'R'};
+// @brief Longest trajectory a client accepts, guards against a corrupt frame
+constexpr uint64_t kMaxWaypoints = uint64_t{1} << 24;
+// @brief Results a connection may have waiting for its writer, a client that
+// falls further behind is disconnected
+constexpr size_t kMaxPendingResponses = 1024;
+
+enum class RequestType : uint32_t {
+  kPlan = 1,
+  kCancel = 2,
+};
+
+/**
+ * @brief Client to server frame
+ */
+struct WireRequest {
+  char magic[4];
+  uint32_t type;
+  uint64_t requestId;
+  uint32_t priority;
+  uint32_t reserved;
+  double startAngles[6];
+  // @brief x, y, z then quaternion x, y, z, w
+  double currentPose[7];
+  double targetPose[7];
+};
+
+/**
+ * @brief Server to client frame, followed by numWaypoints JointAngles
+ */
+struct WireResponse {
+  char magic[4];
+  uint32_t status;
+  uint64_t requestId;
+  double goalError;
+  double solveSecs;
+  uint64_t numWaypoints;
+};
+
+bool readFully(int fd, void *data, size_t size) {
+  auto *bytes = static_cast<char *>(data);
+  while (size > 0) {
+    const ssize_t n = ::recv(fd, bytes, size, 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool writeFully(int fd, const void *data, size_t size) {
+  const auto *bytes = static_cast<const char *>(data);
+  while (size > 0) {
+    // MSG_NOSIGNAL: a vanished peer is an error return, not SIGPIPE
+    const ssize_t n = ::send(fd, bytes, size, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool writeResponse(int fd, uint64_t requestId, const PlanResult &result) {
+  WireResponse response;
+  std::memcpy(response.magic, kResponseMagic, sizeof(kResponseMagic));
+  response.status = static_cast<uint32_t>(result.status);
+  response.requestId = requestId;
+  response.goalError = result.goalError;
+  response.solveSecs = result.solveSecs;
+  response.numWaypoints = result.trajectory.size();
+  return writeFully(fd, &response, sizeof(response)) &&
+         writeFully(fd, result.trajectory.data(),
+                    result.trajectory.size() * sizeof(JointAngles));
+}
+
+bool makeAddress(const std::string &path, sockaddr_un &address) {
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    return false;
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  return true;
+}
+
+void writePose(const Pose &pose, double (&out)[7]) {
+  for (int i = 0; i < 3; ++i) {
+    out[i] = pose.position[i];
+  }
+  for (int i = 0; i < 4; ++i) {
+    out[3 + i] = pose.orientation.coeffs()[i];
+  }
+}
+
+Pose readPose(const double (&in)[7]) {
+  Pose pose(Matrix4d::Identity());
+  pose.position = {in[0], in[1], in[2]};
+  pose.orientation.coeffs() << in[3], in[4], in[5], in[6];
+  return pose;
+}
+}  // namespace
+
+/**
+ * @brief One client of the server
+ * @note Shared with the callbacks of its outstanding requests, so a result
+ * finishing after the client left finds a closed connection, not freed
+ * memory. Callbacks only queue their result; a writer thread per connection
+ * does the blocking socket writes, so a client that stops reading stalls
+ * its own writer, never the service workers.
+ */
+struct PlanningServer::Connection {
+  struct Response {
+    uint64_t requestId;
+    PlanResult result;
+  };
+
+  explicit Connection(int inFd) noexcept : fd(inFd) {}
+  ~Connection() { ::close(fd); }
+  int fd;
+  // @brief Guards pending and open
+  std::mutex writeMutex;
+  std::condition_variable responseReady;
+  // @brief Results waiting for the writer, oldest first
+  std::deque<Response> pending;
+  // @brief False once the client left, fell behind or a write to it failed
+  bool open = true;
+  // @brief Guards outstanding
+  std::mutex requestsMutex;
+  std::map<uint64_t, CancelFlag> outstanding;
+  // @brief Set by the reader when it returns, its thread can then be joined
+  std::atomic<bool> finished{false};
+
+  // @brief Queue a result for the writer, never blocks on the socket
+  void respond(uint64_t requestId, PlanResult &&result) {
+    {
+      std::lock_guard<std::mutex> lock(writeMutex);
+      if (!open) {
+        return;
+      }
+      if (pending.size() < kMaxPendingResponses) {
+        pending.push_back({requestId, std::move(result)});
+        responseReady.notify_one();
+        return;
+      }
+    }
+    disconnect();
+  }
+
+  // @brief Drop pending results and wake the reader and the writer
+  void disconnect() {
+    {
+      std::lock_guard<std::mutex> lock(writeMutex);
+      open = false;
+      pending.clear();
+    }
+    responseReady.notify_one();
+    ::shutdown(fd, SHUT_RDWR);
+  }
+
+  // @brief Writer thread body, sends queued results until disconnect
+  void writeLoop() {
+    std::unique_lock<std::mutex> lock(writeMutex);
+    for (;;) {
+      responseReady.wait(lock, [this] { return !open || !pending.empty(); });
+      if (!open) {
+        return;
+      }
+      const Response response = std::move(pending.front());
+      pending.pop_front();
+      lock.unlock();
+      if (!writeResponse(fd, response.requestId, response.result)) {
+        disconnect();
+        return;
+      }
+      lock.lock();
+    }
+  }
+};
+
+PlanningServer::~PlanningServer() { stop(); }
+
+/**
+ * @brief Start serving on a Unix domain socket
+ * @param path Socket file, an existing file at path is removed first
+ * @return true if the socket could be bound
+ */
+bool PlanningServer::listen(const std::string &path) {
+  stop();
+  sockaddr_un address;
+  if (!makeAddress(path, address)) {
+    return false;
+  }
+  listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (listenFd < 0) {
+    return false;
+  }
+  ::unlink(path.c_str());
+  if (::bind(listenFd, reinterpret_cast<const sockaddr *>(&address),
+             sizeof(address)) != 0 ||
+      ::listen(listenFd, SOMAXCONN) != 0) {
+    ::close(listenFd);
+    listenFd = -1;
+    return false;
+  }
+  socketPath = path;
+  acceptThread = std::thread(&PlanningServer::acceptLoop, this);
+  return true;
+}
+
+/**
+ * @brief Stop accepting, disconnect every client and join the readers
+ * @note Requests of the disconnected clients are cancelled
+ */
+void PlanningServer::stop() {
+  if (listenFd < 0) {
+    return;
+  }
+  // Wakes the blocked accept()
+  ::shutdown(listenFd, SHUT_RDWR);
+  acceptThread.join();
+  ::close(listenFd);
+  listenFd = -1;
+  ::unlink(socketPath.c_str());
+  std::vector<std::thread> finished;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &connection : connections) {
+      // Wakes the blocked recv() of its reader
+      ::shutdown(connection->fd, SHUT_RDWR);
+    }
+    finished.swap(readers);
+    connections.clear();
+  }
+  for (auto &reader : finished) {
+    reader.join();
+  }
+}
+
+void PlanningServer::acceptLoop() {
+  for (;;) {
+    const int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      return;
+    }
+    auto connection = std::make_shared<Connection>(fd);
+    std::lock_guard<std::mutex> lock(mutex);
+    // Forget clients that already left, their readers have returned
+    for (size_t i = 0; i < connections.size();) {
+      if (connections[i]->finished) {
+        readers[i].join();
+        readers.erase(readers.begin() + i);
+        connections.erase(connections.begin() + i);
+      } else {
+        ++i;
+      }
+    }
+    connections.push_back(connection);
+    readers.emplace_back(&PlanningServer::serve, this, connection);
+  }
+}
+
+/**
+ * @brief Read the frames of one client until it disconnects
+ */
+void PlanningServer::serve(const std::shared_ptr<Connection> &connection) {
+  std::thread writer(&Connection::writeLoop, connection.get());
+  WireRequest request;
+  while (readFully(connection->fd, &request, sizeof(request)) &&
+         std::memcmp(request.magic, kRequestMagic, sizeof(kRequestMagic)) ==
+             0) {
+    const uint64_t requestId = request.requestId;
+    if (request.type == static_cast<uint32_t>(RequestType::kCancel)) {
+      std::lock_guard<std::mutex> lock(connection->requestsMutex);
+      auto it = connection->outstanding.find(requestId);
+      if (it != connection->outstanding.end()) {
+        it->second->store(true, std::memory_order_relaxed);
+      }
+      continue;
+    }
+    if (request.type != static_cast<uint32_t>(RequestType::kPlan)) {
+      break;
+    }
+    PlanJob job{JointAngles(), readPose(request.currentPose),
+                readPose(request.targetPose)};
+    std::copy(std::begin(request.startAngles), std::end(request.startAngles),
+              job.startAngles.begin());
+    const auto priority = request.priority != 0 ? PlanPriority::kUrgent
+                                                : PlanPriority::kNormal;
+    CancelFlag flag;
+    {
+      // Registered before the result can arrive, so it is always erased. An
+      // id still in flight is rejected, it would lose the first one's flag.
+      std::lock_guard<std::mutex> lock(connection->requestsMutex);
+      if (connection->outstanding.count(requestId) == 0) {
+        flag = service.submit(
+            job, priority, [connection, requestId](PlanResult &&result) {
+              {
+                std::lock_guard<std::mutex> lock(connection->requestsMutex);
+                connection->outstanding.erase(requestId);
+              }
+              connection->respond(requestId, std::move(result));
+            });
+      }
+      if (flag) {
+        connection->outstanding[requestId] = flag;
+      }
+    }
+    if (!flag) {
+      PlanResult rejected;
+      rejected.status = PlanStatus::kRejected;
+      connection->respond(requestId, std::move(rejected));
+    }
+  }
+  connection->disconnect();
+  {
+    std::lock_guard<std::mutex> lock(connection->requestsMutex);
+    for (const auto &entry : connection->outstanding) {
+      entry.second->store(true, std::memory_order_relaxed);
+    }
+  }
+  writer.join();
+  connection->finished = true;
+}
+
+/**
+ * @brief Connect to a PlanningServer
+ * @param path Socket file the server listens on
+ * @return true if connected
+ */
+bool PlanningClient::connect(const std::string &path) {
+  close();
+  sockaddr_un address;
+  if (!makeAddress(path, address)) {
+    return false;
+  }
+  fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return false;
+  }
+  if (::connect(fd, reinterpret_cast<const sockaddr *>(&address),
+                sizeof(address)) != 0) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void PlanningClient::close() noexcept {
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+bool PlanningClient::send(uint64_t requestId, const PlanJob &job,
+                          PlanPriority priority) {
+  WireRequest request;
+  std::memset(&request, 0, sizeof(request));
+  std::memcpy(request.magic, kRequestMagic, sizeof(kRequestMagic));
+  request.type = static_cast<uint32_t>(RequestType::kPlan);
+  request.requestId = requestId;
+  request.priority = priority == PlanPriority::kUrgent ? 1 : 0;
+  std::copy(job.startAngles.begin(), job.startAngles.end(),
+            request.startAngles);
+  writePose(job.currentPose, request.currentPose);
+  writePose(job.targetPose, request.targetPose);
+  std::lock_guard<std::mutex> lock(writeMutex);
+  return fd >= 0 && writeFully(fd, &request, sizeof(request));
+}
+
+bool PlanningClient::cancel(uint64_t requestId) {
+  WireRequest request;
+  std::memset(&request, 0, sizeof(request));
+  std::memcpy(request.magic, kRequestMagic, sizeof(kRequestMagic));
+  request.type = static_cast<uint32_t>(RequestType::kCancel);
+  request.requestId = requestId;
+  std::lock_guard<std::mutex> lock(writeMutex);
+  return fd >= 0 && writeFully(fd, &request, sizeof(request));
+}
+
+/**
+ * @brief Wait for the next finished request
+ * @param requestId Output, id the request was sent with
+ * @param result Output, status, trajectory and timing
+ * @return false if the connection broke or sent a malformed frame
+ */
+bool PlanningClient::receive(uint64_t &requestId, PlanResult &result) {
+  WireResponse response;
+  if (fd < 0 || !readFully(fd, &response, sizeof(response)) ||
+      std::memcmp(response.magic, kResponseMagic, sizeof(kResponseMagic)) !=
+          0 ||
+      response.status > static_cast<uint32_t>(PlanStatus::kRejected) ||
+      response.numWaypoints > kMaxWaypoints) {
+    return false;
+  }
+  requestId = response.requestId;
+  result.status = static_cast<PlanStatus>(response.status);
+  result.goalError = response.goalError;
+  result.solveSecs = response.solveSecs;
+  result.trajectory.resize(response.numWaypoints);
+  return readFully(fd, result.trajectory.data(),
+                   result.trajectory.size() * sizeof(JointAngles));
+}
+}  // namespace a3c
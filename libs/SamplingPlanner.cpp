@@ -0,0 +1,659 @@
+/**
+ * @file SamplingPlanner.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief RRT-Connect, PRM roadmap construction, queries and roadmap files
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/SamplingPlanner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "include/MappedFile.hpp"
+
+namespace a3c {
+/**
+ * @brief Fixed size roadmap file header, followed by one column of numNodes
+ * doubles per joint, numNodes + 1 offsets and numNeighbors neighbour indices
+ */
+struct RoadmapHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t numJoints;
+  uint64_t dhHash;
+  uint64_t numNodes;
+  uint64_t numNeighbors;
+};
+
+namespace {
+constexpr char kMagic[8] = {'A', '3', 'C', 'P', 'R', 'M', '\0', '\0'};
+constexpr uint32_t kVersion = 1;
+// @brief Entries whose distances are computed per pass of a nearest
+// neighbour scan, sized to stay in L1
+constexpr size_t kScanBlock = 256;
+// @brief Nodes or edges handed to a worker as one task
+constexpr size_t kTaskBlock = 64;
+static_assert(ConfigurationTable::mNumJoints == 6,
+              "ConfigurationTable::distances unrolls six joints");
+
+double distance(const JointAngles &a, const JointAngles &b) noexcept {
+  double sum = 0.0;
+  for (size_t j = 0; j < a.size(); ++j) {
+    sum += (a[j] - b[j]) * (a[j] - b[j]);
+  }
+  return std::sqrt(sum);
+}
+
+JointAngles blend(const JointAngles &a, const JointAngles &b, double t) noexcept {
+  JointAngles q;
+  for (size_t j = 0; j < q.size(); ++j) {
+    q[j] = a[j] + t * (b[j] - a[j]);
+  }
+  return q;
+}
+
+/**
+ * @brief One RRT, nodes plus the parent of each, the root is its own parent
+ */
+struct Tree {
+  ConfigurationTable nodes;
+  std::vector<uint32_t> parents;
+
+  void add(const JointAngles &q, size_t parent) {
+    nodes.add(q);
+    parents.push_back(static_cast<uint32_t>(parent));
+  }
+  // @brief Configurations from node up to the root
+  void pathToRoot(size_t node, std::vector<JointAngles> &path) const {
+    for (;;) {
+      path.push_back(nodes[node]);
+      if (parents[node] == node) {
+        return;
+      }
+      node = parents[node];
+    }
+  }
+};
+
+/**
+ * @brief Result of growing a tree towards a configuration
+ */
+enum class Extension {
+  kTrapped,
+  kAdvanced,
+  kReached,
+};
+}  // namespace
+
+void ConfigurationTable::add(const JointAngles &q) {
+  for (size_t j = 0; j < mNumJoints; ++j) {
+    columns[j].push_back(q[j]);
+  }
+}
+
+void ConfigurationTable::clear() noexcept {
+  for (auto &column : columns) {
+    column.clear();
+  }
+}
+
+void ConfigurationTable::reserve(size_t count) {
+  for (auto &column : columns) {
+    column.reserve(count);
+  }
+}
+
+JointAngles ConfigurationTable::operator[](size_t i) const noexcept {
+  JointAngles q;
+  for (size_t j = 0; j < mNumJoints; ++j) {
+    q[j] = columns[j][i];
+  }
+  return q;
+}
+
+void ConfigurationTable::distances(const JointAngles &q, size_t begin,
+                                   size_t count, double *out) const noexcept {
+  // One fused pass over the six columns, vectorized across entries
+  const double *c0 = columns[0].data() + begin;
+  const double *c1 = columns[1].data() + begin;
+  const double *c2 = columns[2].data() + begin;
+  const double *c3 = columns[3].data() + begin;
+  const double *c4 = columns[4].data() + begin;
+  const double *c5 = columns[5].data() + begin;
+  for (size_t i = 0; i < count; ++i) {
+    const double d0 = c0[i] - q[0];
+    const double d1 = c1[i] - q[1];
+    const double d2 = c2[i] - q[2];
+    const double d3 = c3[i] - q[3];
+    const double d4 = c4[i] - q[4];
+    const double d5 = c5[i] - q[5];
+    out[i] = d0 * d0 + d1 * d1 + d2 * d2 + d3 * d3 + d4 * d4 + d5 * d5;
+  }
+}
+
+/**
+ * @brief Linear scan in blocks of kScanBlock entries
+ * @param q Query configuration
+ * @return size_t Index of the closest entry, size() if the table is empty
+ */
+size_t ConfigurationTable::nearest(const JointAngles &q) const noexcept {
+  double block[kScanBlock];
+  double bestDistance = std::numeric_limits<double>::infinity();
+  size_t best = size();
+  for (size_t begin = 0; begin < size(); begin += kScanBlock) {
+    const size_t count = std::min(kScanBlock, size() - begin);
+    distances(q, begin, count, block);
+    for (size_t i = 0; i < count; ++i) {
+      if (block[i] < bestDistance) {
+        bestDistance = block[i];
+        best = begin + i;
+      }
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Linear scan keeping the k best in a max-heap
+ * @param q Query configuration
+ * @param k Neighbours wanted, fewer if the table is smaller
+ * @param indices Output, closest first
+ */
+void ConfigurationTable::kNearest(const JointAngles &q, size_t k,
+                                  std::vector<size_t> &indices) const {
+  indices.clear();
+  k = std::min(k, size());
+  if (k == 0) {
+    return;
+  }
+  double block[kScanBlock];
+  std::vector<std::pair<double, size_t>> heap;
+  heap.reserve(k);
+  for (size_t begin = 0; begin < size(); begin += kScanBlock) {
+    const size_t count = std::min(kScanBlock, size() - begin);
+    distances(q, begin, count, block);
+    for (size_t i = 0; i < count; ++i) {
+      if (heap.size() < k) {
+        heap.emplace_back(block[i], begin + i);
+        std::push_heap(heap.begin(), heap.end());
+      } else if (block[i] < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = {block[i], begin + i};
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+  }
+  std::sort_heap(heap.begin(), heap.end());
+  for (const auto &entry : heap) {
+    indices.push_back(entry.second);
+  }
+}
+
+/**
+ * @brief Write the roadmap, nodes column by column
+ * @param path Output file, overwritten
+ * @param fk Arm the roadmap was built for, its DH hash goes into the header
+ * @return true if the file was written completely
+ */
+bool Roadmap::save(const std::string &path,
+                   const ForwardKinematics &fk) const {
+  if (offsets.size() != numNodes() + 1) {
+    return false;
+  }
+  RoadmapHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.numJoints = ConfigurationTable::mNumJoints;
+  header.dhHash = fk.dhHash();
+  header.numNodes = numNodes();
+  header.numNeighbors = neighbors.size();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (size_t j = 0; j < ConfigurationTable::mNumJoints; ++j) {
+    out.write(reinterpret_cast<const char *>(nodes.column(j).data()),
+              numNodes() * sizeof(double));
+  }
+  out.write(reinterpret_cast<const char *>(offsets.data()),
+            offsets.size() * sizeof(uint64_t));
+  out.write(reinterpret_cast<const char *>(neighbors.data()),
+            neighbors.size() * sizeof(uint32_t));
+  return static_cast<bool>(out.flush());
+}
+
+/**
+ * @brief Read a roadmap written by save
+ * @param path Roadmap file
+ * @param fk Arm the roadmap must have been built for
+ * @return true if the file is a complete, consistent roadmap of fk, the
+ * roadmap is left empty otherwise
+ */
+bool Roadmap::load(const std::string &path, const ForwardKinematics &fk) {
+  nodes.clear();
+  offsets.clear();
+  neighbors.clear();
+  MappedFile file;
+  if (!file.open(path) || file.size() < sizeof(RoadmapHeader)) {
+    return false;
+  }
+  const auto *header = static_cast<const RoadmapHeader *>(file.data());
+  const size_t numJoints = ConfigurationTable::mNumJoints;
+  // Bound the counts first so the size computation cannot wrap around
+  if (header->numNodes > file.size() / (numJoints * sizeof(double)) ||
+      header->numNeighbors > file.size() / sizeof(uint32_t)) {
+    return false;
+  }
+  const size_t expectedSize =
+      sizeof(RoadmapHeader) + header->numNodes * numJoints * sizeof(double) +
+      (header->numNodes + 1) * sizeof(uint64_t) +
+      header->numNeighbors * sizeof(uint32_t);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion || header->numJoints != numJoints ||
+      header->dhHash != fk.dhHash() ||
+      header->numNodes > std::numeric_limits<uint32_t>::max() ||
+      file.size() != expectedSize) {
+    return false;
+  }
+  const auto *columns = reinterpret_cast<const double *>(header + 1);
+  const auto *fileOffsets =
+      reinterpret_cast<const uint64_t *>(columns + header->numNodes * numJoints);
+  const auto *fileNeighbors =
+      reinterpret_cast<const uint32_t *>(fileOffsets + header->numNodes + 1);
+  offsets.assign(fileOffsets, fileOffsets + header->numNodes + 1);
+  neighbors.assign(fileNeighbors, fileNeighbors + header->numNeighbors);
+  // Queries index with these, reject a file that would read out of bounds
+  bool consistent =
+      offsets.front() == 0 && offsets.back() == neighbors.size() &&
+      std::is_sorted(offsets.begin(), offsets.end()) &&
+      std::all_of(neighbors.begin(), neighbors.end(), [&](uint32_t n) {
+        return n < header->numNodes;
+      });
+  if (!consistent) {
+    offsets.clear();
+    neighbors.clear();
+    return false;
+  }
+  nodes.reserve(header->numNodes);
+  for (size_t i = 0; i < header->numNodes; ++i) {
+    JointAngles q;
+    for (size_t j = 0; j < numJoints; ++j) {
+      q[j] = columns[j * header->numNodes + i];
+    }
+    nodes.add(q);
+  }
+  return true;
+}
+
+/**
+ * @brief Construct a new SamplingPlanner object and start its workers
+ *
+ * @param inValidator State check, called concurrently from the workers
+ * @param inOptions Joint limits, resolutions, seeds and worker count
+ */
+SamplingPlanner::SamplingPlanner(StateValidator inValidator,
+                                 const SamplingPlannerOptions &inOptions)
+    : validator(std::move(inValidator)),
+      options(inOptions),
+      pool(inOptions.numThreads) {}
+
+JointAngles SamplingPlanner::sample(std::mt19937_64 &rng) const {
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  JointAngles q;
+  for (size_t j = 0; j < q.size(); ++j) {
+    q[j] = options.limits.lower[j] +
+           unit(rng) * (options.limits.upper[j] - options.limits.lower[j]);
+  }
+  return q;
+}
+
+/**
+ * @brief Check the straight joint space segment from a to b
+ * @note a is assumed valid. The states are visited coarse to fine, halving
+ * the spacing each round, so a blocked segment is usually rejected after a
+ * few checks instead of after walking up to the obstacle.
+ * @return true if b and every state in between are valid
+ */
+bool SamplingPlanner::motionValid(const JointAngles &a,
+                                  const JointAngles &b) const {
+  if (!validator(b)) {
+    return false;
+  }
+  const size_t numSegments = static_cast<size_t>(
+      std::ceil(distance(a, b) / options.edgeResolution));
+  // State i is visited in the round of its lowest set bit
+  size_t step = 1;
+  while (2 * step < numSegments) {
+    step *= 2;
+  }
+  for (; step > 0; step /= 2) {
+    for (size_t i = step; i < numSegments; i += 2 * step) {
+      if (!validator(blend(a, b, static_cast<double>(i) / numSegments))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Bidirectional RRT, one pair of trees per worker
+ * @param start Start configuration
+ * @param goal Goal configuration
+ * @param path Output, start to goal, joined by valid straight segments
+ * @return true if a path was found
+ */
+bool SamplingPlanner::rrtConnect(const JointAngles &start,
+                                 const JointAngles &goal,
+                                 std::vector<JointAngles> &path) {
+  path.clear();
+  if (!validator(start) || !validator(goal)) {
+    return false;
+  }
+  if (motionValid(start, goal)) {
+    path = {start, goal};
+    return true;
+  }
+  const uint64_t query = queryCount++;
+  std::atomic<bool> found{false};
+  pool.parallelFor(pool.size(), [&](size_t worker) {
+    std::seed_seq seed{options.randomSeed, static_cast<uint32_t>(query),
+                       static_cast<uint32_t>(worker)};
+    std::mt19937_64 rng(seed);
+    Tree trees[2];
+    trees[0].add(start, 0);
+    trees[1].add(goal, 0);
+    // Grow a towards target by at most stepSize
+    const auto extend = [this](Tree &tree, const JointAngles &target,
+                               size_t &added) {
+      const size_t near = tree.nodes.nearest(target);
+      const JointAngles from = tree.nodes[near];
+      const double gap = distance(from, target);
+      const bool reaches = gap <= options.stepSize;
+      const JointAngles to =
+          reaches ? target : blend(from, target, options.stepSize / gap);
+      if (!motionValid(from, to)) {
+        return Extension::kTrapped;
+      }
+      added = tree.nodes.size();
+      tree.add(to, near);
+      return reaches ? Extension::kReached : Extension::kAdvanced;
+    };
+    size_t grow = 0;
+    for (size_t iteration = 0; iteration < options.maxIterations &&
+                               !found.load(std::memory_order_relaxed);
+         ++iteration, grow ^= 1) {
+      Tree &a = trees[grow];
+      Tree &b = trees[grow ^ 1];
+      size_t newA = 0;
+      if (extend(a, sample(rng), newA) == Extension::kTrapped) {
+        continue;
+      }
+      const JointAngles target = a.nodes[newA];
+      size_t newB = 0;
+      Extension result;
+      do {
+        result = extend(b, target, newB);
+      } while (result == Extension::kAdvanced);
+      if (result != Extension::kReached) {
+        continue;
+      }
+      // Only the first tree to connect writes path
+      if (found.exchange(true)) {
+        return;
+      }
+      // trees[0] is rooted at start, walk it backwards
+      const size_t fromStart = grow == 0 ? newA : newB;
+      const size_t fromGoal = grow == 0 ? newB : newA;
+      trees[0].pathToRoot(fromStart, path);
+      std::reverse(path.begin(), path.end());
+      // fromGoal is the same configuration as fromStart
+      trees[1].pathToRoot(trees[1].parents[fromGoal], path);
+      return;
+    }
+  });
+  return !path.empty();
+}
+
+/**
+ * @brief Sample and connect a roadmap of the valid joint space
+ * @note Three parallel passes: validity of the samples, the k nearest of
+ * every node, then the edges. A pair that is in both neighbour lists is
+ * checked once.
+ * @param numSamples Valid configurations in the roadmap
+ * @param roadmap Output, replaced
+ */
+void SamplingPlanner::buildRoadmap(size_t numSamples, Roadmap &roadmap) {
+  roadmap.nodes.clear();
+  roadmap.offsets.clear();
+  roadmap.neighbors.clear();
+  roadmap.nodes.reserve(numSamples);
+  std::mt19937_64 rng(options.randomSeed);
+  std::vector<JointAngles> candidates;
+  std::vector<char> valid;
+  while (roadmap.nodes.size() < numSamples) {
+    // Oversampled since part of the joint space is blocked
+    candidates.resize(2 * (numSamples - roadmap.nodes.size()));
+    for (auto &candidate : candidates) {
+      candidate = sample(rng);
+    }
+    valid.assign(candidates.size(), 0);
+    pool.parallelFor((candidates.size() + kTaskBlock - 1) / kTaskBlock,
+                     [&](size_t task) {
+                       const size_t end = std::min(candidates.size(),
+                                                   (task + 1) * kTaskBlock);
+                       for (size_t i = task * kTaskBlock; i < end; ++i) {
+                         valid[i] = validator(candidates[i]);
+                       }
+                     });
+    const size_t before = roadmap.nodes.size();
+    for (size_t i = 0;
+         i < candidates.size() && roadmap.nodes.size() < numSamples; ++i) {
+      if (valid[i]) {
+        roadmap.nodes.add(candidates[i]);
+      }
+    }
+    // Next to no free space, keep what was found
+    if (roadmap.nodes.size() == before) {
+      break;
+    }
+  }
+
+  const size_t numNodes = roadmap.nodes.size();
+  const size_t k =
+      numNodes > 0 ? std::min(options.numNeighbors, numNodes - 1) : 0;
+  // Row i holds the k nearest of node i, itself excluded
+  std::vector<uint32_t> knn(numNodes * k);
+  const size_t numNodeTasks = (numNodes + kTaskBlock - 1) / kTaskBlock;
+  pool.parallelFor(numNodeTasks, [&](size_t task) {
+    std::vector<size_t> nearest;
+    const size_t end = std::min(numNodes, (task + 1) * kTaskBlock);
+    for (size_t i = task * kTaskBlock; i < end; ++i) {
+      roadmap.nodes.kNearest(roadmap.nodes[i], k + 1, nearest);
+      size_t out = 0;
+      for (size_t n : nearest) {
+        if (n != i && out < k) {
+          knn[i * k + out++] = static_cast<uint32_t>(n);
+        }
+      }
+    }
+  });
+
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  edges.reserve(numNodes * k);
+  for (size_t i = 0; i < numNodes; ++i) {
+    for (size_t m = 0; m < k; ++m) {
+      const uint32_t j = knn[i * k + m];
+      const auto row = knn.begin() + j * k;
+      if (j < i && std::find(row, row + k, i) != row + k) {
+        continue;
+      }
+      edges.emplace_back(static_cast<uint32_t>(i), j);
+    }
+  }
+  std::vector<char> edgeValid(edges.size(), 0);
+  pool.parallelFor((edges.size() + kTaskBlock - 1) / kTaskBlock,
+                   [&](size_t task) {
+                     const size_t end =
+                         std::min(edges.size(), (task + 1) * kTaskBlock);
+                     for (size_t e = task * kTaskBlock; e < end; ++e) {
+                       edgeValid[e] =
+                           motionValid(roadmap.nodes[edges[e].first],
+                                       roadmap.nodes[edges[e].second]);
+                     }
+                   });
+
+  // Counting sort of both directions of every valid edge into rows
+  roadmap.offsets.assign(numNodes + 1, 0);
+  for (size_t e = 0; e < edges.size(); ++e) {
+    if (edgeValid[e]) {
+      ++roadmap.offsets[edges[e].first + 1];
+      ++roadmap.offsets[edges[e].second + 1];
+    }
+  }
+  for (size_t i = 0; i < numNodes; ++i) {
+    roadmap.offsets[i + 1] += roadmap.offsets[i];
+  }
+  roadmap.neighbors.resize(roadmap.offsets.back());
+  std::vector<uint64_t> next(roadmap.offsets.begin(),
+                             roadmap.offsets.end() - 1);
+  for (size_t e = 0; e < edges.size(); ++e) {
+    if (edgeValid[e]) {
+      roadmap.neighbors[next[edges[e].first]++] = edges[e].second;
+      roadmap.neighbors[next[edges[e].second]++] = edges[e].first;
+    }
+  }
+}
+
+/**
+ * @brief Attach start and goal to the roadmap and search it with Dijkstra
+ * @param roadmap Roadmap built with this planner's validator
+ * @param start Start configuration
+ * @param goal Goal configuration
+ * @param path Output, start to goal, joined by valid straight segments
+ * @return true if a path was found
+ */
+bool SamplingPlanner::query(const Roadmap &roadmap, const JointAngles &start,
+                            const JointAngles &goal,
+                            std::vector<JointAngles> &path) {
+  path.clear();
+  if (!validator(start) || !validator(goal)) {
+    return false;
+  }
+  if (motionValid(start, goal)) {
+    path = {start, goal};
+    return true;
+  }
+  const size_t numNodes = roadmap.numNodes();
+  if (numNodes == 0 || roadmap.offsets.size() != numNodes + 1) {
+    return false;
+  }
+  std::vector<size_t> startNear;
+  std::vector<size_t> goalNear;
+  roadmap.nodes.kNearest(start, options.numNeighbors, startNear);
+  roadmap.nodes.kNearest(goal, options.numNeighbors, goalNear);
+  const size_t numStart = startNear.size();
+  std::vector<char> attached(numStart + goalNear.size(), 0);
+  pool.parallelFor(attached.size(), [&](size_t a) {
+    // Segments run from the node, whose validity is known
+    attached[a] = a < numStart
+                      ? motionValid(roadmap.nodes[startNear[a]], start)
+                      : motionValid(roadmap.nodes[goalNear[a - numStart]],
+                                    goal);
+  });
+
+  // Node numNodes stands for the goal, reached from its attached nodes
+  const size_t goalNode = numNodes;
+  const size_t noParent = std::numeric_limits<size_t>::max();
+  std::vector<double> cost(numNodes + 1,
+                           std::numeric_limits<double>::infinity());
+  std::vector<size_t> parent(numNodes + 1, noParent);
+  std::vector<double> toGoal(numNodes, -1.0);
+  for (size_t a = 0; a < goalNear.size(); ++a) {
+    if (attached[numStart + a]) {
+      toGoal[goalNear[a]] = distance(roadmap.nodes[goalNear[a]], goal);
+    }
+  }
+  using Entry = std::pair<double, size_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  for (size_t a = 0; a < numStart; ++a) {
+    if (attached[a]) {
+      const size_t node = startNear[a];
+      cost[node] = distance(start, roadmap.nodes[node]);
+      open.emplace(cost[node], node);
+    }
+  }
+  while (!open.empty()) {
+    const Entry top = open.top();
+    open.pop();
+    const size_t node = top.second;
+    if (top.first > cost[node]) {
+      continue;
+    }
+    if (node == goalNode) {
+      break;
+    }
+    const JointAngles q = roadmap.nodes[node];
+    if (toGoal[node] >= 0.0 && cost[node] + toGoal[node] < cost[goalNode]) {
+      cost[goalNode] = cost[node] + toGoal[node];
+      parent[goalNode] = node;
+      open.emplace(cost[goalNode], goalNode);
+    }
+    for (uint64_t e = roadmap.offsets[node]; e < roadmap.offsets[node + 1];
+         ++e) {
+      const size_t next = roadmap.neighbors[e];
+      const double nextCost = cost[node] + distance(q, roadmap.nodes[next]);
+      if (nextCost < cost[next]) {
+        cost[next] = nextCost;
+        parent[next] = node;
+        open.emplace(nextCost, next);
+      }
+    }
+  }
+  if (parent[goalNode] == noParent) {
+    return false;
+  }
+  path.push_back(goal);
+  for (size_t node = parent[goalNode]; node != noParent; node = parent[node]) {
+    path.push_back(roadmap.nodes[node]);
+  }
+  path.push_back(start);
+  std::reverse(path.begin(), path.end());
+  return true;
+}
+
+/**
+ * @brief Densify a path for execution or collision checking
+ * @param path Waypoints joined by straight joint space segments
+ * @param maxStep Largest joint space distance between output states
+ * @return std::vector<JointAngles> path with the segments subdivided
+ */
+std::vector<JointAngles> SamplingPlanner::interpolate(
+    const std::vector<JointAngles> &path, double maxStep) {
+  std::vector<JointAngles> dense;
+  if (path.empty()) {
+    return dense;
+  }
+  dense.push_back(path.front());
+  for (size_t i = 1; i < path.size(); ++i) {
+    const size_t numSegments = std::max<size_t>(
+        1, static_cast<size_t>(
+               std::ceil(distance(path[i - 1], path[i]) / maxStep)));
+    for (size_t s = 1; s <= numSegments; ++s) {
+      dense.push_back(blend(path[i - 1], path[i],
+                           static_cast<double>(s) / numSegments));
+    }
+  }
+  return dense;
+}
+}  // namespace a3c
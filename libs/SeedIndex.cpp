@@ -0,0 +1,305 @@
+/**
+ * @file SeedIndex.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Seed index build, mapping and queries
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/SeedIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace a3c {
+/**
+ * @brief Fixed size file header, followed by the offsets and entries
+ */
+struct SeedIndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t dhHash;
+  uint64_t numEntries;
+  double cellSize;
+  // @brief Corner of voxel (0, 0, 0)
+  double origin[3];
+  uint32_t dims[3];
+  uint32_t padding;
+};
+
+namespace {
+constexpr char kMagic[8] = {'A', '3', 'C', 'S', 'E', 'E', 'D', '\0'};
+constexpr uint32_t kVersion = 1;
+static_assert(sizeof(SeedEntry) == 13 * sizeof(double),
+              "SeedEntry is written as packed doubles");
+
+size_t numCells(const SeedIndexHeader &header) noexcept {
+  return static_cast<size_t>(header.dims[0]) * header.dims[1] * header.dims[2];
+}
+
+/**
+ * @brief Voxel coordinates of position, clamped to one cell outside the grid
+ * @return false if position is outside the grid
+ */
+bool cellOf(const SeedIndexHeader &header, const Eigen::Vector3d &position,
+            int64_t cell[3]) noexcept {
+  bool inside = true;
+  for (int k = 0; k < 3; ++k) {
+    const double scaled = (position[k] - header.origin[k]) / header.cellSize;
+    const double limit = static_cast<double>(header.dims[k]);
+    cell[k] = static_cast<int64_t>(
+        std::floor(std::max(-1.0, std::min(scaled, limit))));
+    inside &= cell[k] >= 0 && cell[k] < header.dims[k];
+  }
+  return inside;
+}
+
+size_t cellIndex(const SeedIndexHeader &header,
+                 const int64_t cell[3]) noexcept {
+  return (static_cast<size_t>(cell[2]) * header.dims[1] +
+          static_cast<size_t>(cell[1])) *
+             header.dims[0] +
+         static_cast<size_t>(cell[0]);
+}
+}  // namespace
+
+/**
+ * @brief Sample random configurations and write them binned by voxel
+ * @param path Output file, overwritten
+ * @param fk Arm to sample, its DH hash goes into the header
+ * @param options Sample count, voxel size and sampler seed
+ * @return true if the file was written completely
+ */
+bool SeedIndex::build(const std::string &path, const ForwardKinematics &fk,
+                      const SeedIndexOptions &options) {
+  if (options.numSamples == 0 || !(options.cellSize > 0)) {
+    return false;
+  }
+  std::mt19937_64 rng(options.randomSeed);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  std::vector<SeedEntry> samples(options.numSamples);
+  Eigen::Vector3d lower = Eigen::Vector3d::Constant(
+      std::numeric_limits<double>::infinity());
+  Eigen::Vector3d upper = -lower;
+  for (auto &sample : samples) {
+    JointAngles ja;
+    for (size_t j = 0; j < ja.size(); ++j) {
+      ja[j] = angle(rng);
+      sample.jointAngles[j] = ja[j];
+    }
+    const Pose pose = fk.fk(ja);
+    for (int k = 0; k < 3; ++k) {
+      sample.position[k] = pose.position[k];
+    }
+    for (int k = 0; k < 4; ++k) {
+      sample.orientation[k] = pose.orientation.coeffs()[k];
+    }
+    lower = lower.cwiseMin(pose.position);
+    upper = upper.cwiseMax(pose.position);
+  }
+
+  SeedIndexHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.dhHash = fk.dhHash();
+  header.numEntries = samples.size();
+  header.cellSize = options.cellSize;
+  for (int k = 0; k < 3; ++k) {
+    header.origin[k] = lower[k];
+    header.dims[k] = static_cast<uint32_t>(
+                         std::floor((upper[k] - lower[k]) / options.cellSize)) +
+                     1;
+  }
+
+  // Counting sort of the samples by voxel
+  std::vector<uint64_t> offsets(numCells(header) + 1, 0);
+  std::vector<size_t> cellOfSample(samples.size());
+  for (size_t i = 0; i < samples.size(); ++i) {
+    int64_t cell[3];
+    cellOf(header, Eigen::Map<const Eigen::Vector3d>(samples[i].position),
+           cell);
+    cellOfSample[i] = cellIndex(header, cell);
+    ++offsets[cellOfSample[i] + 1];
+  }
+  for (size_t c = 0; c + 1 < offsets.size(); ++c) {
+    offsets[c + 1] += offsets[c];
+  }
+  std::vector<SeedEntry> sorted(samples.size());
+  std::vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    sorted[next[cellOfSample[i]]++] = samples[i];
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(offsets.data()),
+            offsets.size() * sizeof(uint64_t));
+  out.write(reinterpret_cast<const char *>(sorted.data()),
+            sorted.size() * sizeof(SeedEntry));
+  return static_cast<bool>(out.flush());
+}
+
+/**
+ * @brief Map an index file read only
+ * @param path File written by build()
+ * @param fk Arm the index must have been built for
+ * @return true if the file is a complete index of fk
+ */
+bool SeedIndex::open(const std::string &path, const ForwardKinematics &fk) {
+  close();
+  if (!file.open(path) || file.size() < sizeof(SeedIndexHeader)) {
+    close();
+    return false;
+  }
+  header = static_cast<const SeedIndexHeader *>(file.data());
+  // Bound the counts first so the size computation cannot wrap around
+  const size_t maxOffsets = file.size() / sizeof(uint64_t);
+  size_t cells = 1;
+  for (int k = 0; k < 3; ++k) {
+    if (header->dims[k] != 0 && cells > maxOffsets / header->dims[k]) {
+      close();
+      return false;
+    }
+    cells *= header->dims[k];
+  }
+  if (cells >= maxOffsets ||
+      header->numEntries > file.size() / sizeof(SeedEntry)) {
+    close();
+    return false;
+  }
+  const size_t expectedSize = sizeof(SeedIndexHeader) +
+                              (cells + 1) * sizeof(uint64_t) +
+                              header->numEntries * sizeof(SeedEntry);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion || header->dhHash != fk.dhHash() ||
+      !(header->cellSize > 0) || file.size() != expectedSize) {
+    close();
+    return false;
+  }
+  cellOffsets = reinterpret_cast<const uint64_t *>(header + 1);
+  entries = reinterpret_cast<const SeedEntry *>(cellOffsets + cells + 1);
+  // Cell offsets must start at 0, never decrease and end at numEntries
+  if (cellOffsets[0] != 0 || cellOffsets[cells] != header->numEntries) {
+    close();
+    return false;
+  }
+  for (size_t c = 0; c < cells; ++c) {
+    if (cellOffsets[c + 1] < cellOffsets[c]) {
+      close();
+      return false;
+    }
+  }
+  return true;
+}
+
+void SeedIndex::close() noexcept {
+  file.close();
+  header = nullptr;
+  cellOffsets = nullptr;
+  entries = nullptr;
+}
+
+size_t SeedIndex::numEntries() const noexcept {
+  return isOpen() ? header->numEntries : 0;
+}
+
+/**
+ * @brief Search rings of voxels around the target
+ * @note The score is position error + orientationWeight * angle. Every sample
+ * in ring r + 1 is at least r cells away, so the search stops once the best
+ * score is within that bound.
+ * @param target Pose to seed IK for
+ * @param seed Output, joint angles of the best sample
+ * @param orientationWeight Metres per radian of orientation error
+ * @return true if a sample was found
+ */
+bool SeedIndex::nearestSeed(const Pose &target, JointAngles &seed,
+                            double orientationWeight) const noexcept {
+  if (!isOpen() || header->numEntries == 0) {
+    return false;
+  }
+  int64_t center[3];
+  cellOf(*header, target.position, center);
+  const int64_t maxRing = static_cast<int64_t>(
+      std::max({header->dims[0], header->dims[1], header->dims[2]}));
+  double bestScore = std::numeric_limits<double>::infinity();
+  const SeedEntry *best = nullptr;
+  for (int64_t ring = 0; ring <= maxRing; ++ring) {
+    int64_t low[3];
+    int64_t high[3];
+    for (int k = 0; k < 3; ++k) {
+      low[k] = std::max<int64_t>(0, center[k] - ring);
+      high[k] = std::min<int64_t>(header->dims[k] - 1, center[k] + ring);
+    }
+    for (int64_t z = low[2]; z <= high[2]; ++z) {
+      for (int64_t y = low[1]; y <= high[1]; ++y) {
+        for (int64_t x = low[0]; x <= high[0]; ++x) {
+          // Only the shell of the ring, inner cells were visited before
+          const int64_t distance =
+              std::max({std::abs(x - center[0]), std::abs(y - center[1]),
+                        std::abs(z - center[2])});
+          if (distance != ring) {
+            continue;
+          }
+          const int64_t cell[3] = {x, y, z};
+          const size_t index = cellIndex(*header, cell);
+          for (uint64_t e = cellOffsets[index]; e < cellOffsets[index + 1];
+               ++e) {
+            const SeedEntry &entry = entries[e];
+            const double positionError =
+                (Eigen::Map<const Eigen::Vector3d>(entry.position) -
+                 target.position)
+                    .norm();
+            if (positionError >= bestScore) {
+              continue;
+            }
+            const Eigen::Quaterniond orientation(
+                entry.orientation[3], entry.orientation[0],
+                entry.orientation[1], entry.orientation[2]);
+            const double score =
+                positionError +
+                orientationWeight * orientation.angularDistance(
+                                        target.orientation);
+            if (score < bestScore) {
+              bestScore = score;
+              best = &entry;
+            }
+          }
+        }
+      }
+    }
+    if (best != nullptr && bestScore <= ring * header->cellSize) {
+      break;
+    }
+  }
+  if (best == nullptr) {
+    return false;
+  }
+  std::copy(best->jointAngles, best->jointAngles + seed.size(), seed.begin());
+  return true;
+}
+
+/**
+ * @brief Occupancy of the voxel holding position
+ * @note Approximate at the voxel resolution, a boundary voxel may be only
+ * partly reachable
+ */
+bool SeedIndex::isReachable(const Eigen::Vector3d &position) const noexcept {
+  int64_t cell[3];
+  if (!isOpen() || !cellOf(*header, position, cell)) {
+    return false;
+  }
+  const size_t index = cellIndex(*header, cell);
+  return cellOffsets[index + 1] > cellOffsets[index];
+}
+}  // namespace a3c
@@ -0,0 +1,120 @@
+/**
+ * @file SelfCollision.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Capsule self-collision implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/SelfCollision.hpp"
+
+namespace a3c {
+constexpr const size_t SelfCollision::mNumLinks;
+constexpr const size_t SelfCollision::mNumPairs;
+constexpr const size_t SelfCollision::mNumLanes;
+
+/**
+ * @brief Construct a new SelfCollision object
+ *
+ * @param fk Source of the link geometry
+ * @param inModel Capsule radius of every link
+ */
+SelfCollision::SelfCollision(const ForwardKinematics &fk,
+                             const CapsuleModel &inModel)
+    : model(inModel), prototype(fk) {
+  size_t lane = 0;
+  for (size_t i = 0; i < mNumLinks; ++i) {
+    for (size_t j = i + 2; j < mNumLinks; ++j) {
+      pairs[lane] = {i, j};
+      radiusSums[lane] = model.radii[i] + model.radii[j];
+      ++lane;
+    }
+  }
+  for (; lane < mNumLanes; ++lane) {
+    pairs[lane] = pairs[0];
+    radiusSums[lane] = 0;
+  }
+}
+
+/**
+ * @brief Closest distance between the two link segments of every lane
+ * @note Closest points of segments P1 + s d1 and P2 + t d2: t from the
+ * clamped unconstrained s, then s again from the clamped t. Parallel
+ * segments start from s = 0, degenerate segments have their divisions
+ * guarded, so every lane takes the same instructions.
+ */
+SelfCollision::Lanes SelfCollision::distances(
+    const IncrementalForwardKinematics &fk) const noexcept {
+  Eigen::Array<double, mNumLanes, 3> p1;
+  Eigen::Array<double, mNumLanes, 3> d1;
+  Eigen::Array<double, mNumLanes, 3> p2;
+  Eigen::Array<double, mNumLanes, 3> d2;
+  for (size_t k = 0; k < mNumLanes; ++k) {
+    const auto &start1 = fk.linkFrame(pairs[k].first).origin;
+    const auto &start2 = fk.linkFrame(pairs[k].second).origin;
+    p1.row(k) = start1.transpose();
+    d1.row(k) = (fk.linkFrame(pairs[k].first + 1).origin - start1).transpose();
+    p2.row(k) = start2.transpose();
+    d2.row(k) = (fk.linkFrame(pairs[k].second + 1).origin - start2).transpose();
+  }
+  const Eigen::Array<double, mNumLanes, 3> r = p1 - p2;
+  const Lanes a = (d1 * d1).rowwise().sum();
+  const Lanes e = (d2 * d2).rowwise().sum();
+  const Lanes b = (d1 * d2).rowwise().sum();
+  const Lanes c = (d1 * r).rowwise().sum();
+  const Lanes f = (d2 * r).rowwise().sum();
+  constexpr double kEpsilon = 1E-12;
+  const Lanes safeA = a.max(kEpsilon);
+  const Lanes safeE = e.max(kEpsilon);
+  const Lanes denominator = a * e - b * b;
+  Lanes s = (denominator > kEpsilon)
+                .select(((b * f - c * e) / denominator.max(kEpsilon))
+                            .max(0.0)
+                            .min(1.0),
+                        Lanes::Zero());
+  const Lanes t = ((b * s + f) / safeE).max(0.0).min(1.0);
+  s = ((b * t - c) / safeA).max(0.0).min(1.0);
+  Eigen::Array<double, mNumLanes, 3> gap = r;
+  gap += d1.colwise() * s;
+  gap -= d2.colwise() * t;
+  return gap.square().rowwise().sum().sqrt();
+}
+
+/**
+ * @brief Smallest clearance between non-adjacent capsules
+ * @param jointAngles Joint angles in radians
+ * @return double Metres, negative if two capsules overlap
+ */
+double SelfCollision::clearance(const JointAngles &jointAngles) const
+    noexcept {
+  IncrementalForwardKinematics fk = prototype;
+  fk.update(jointAngles);
+  return (distances(fk) - radiusSums).minCoeff();
+}
+
+bool SelfCollision::inCollision(const JointAngles &jointAngles) const
+    noexcept {
+  return clearance(jointAngles) < 0;
+}
+
+/**
+ * @brief Check a trajectory waypoint by waypoint
+ * @param trajectory Joint angles of every waypoint
+ * @return size_t Index of the first colliding waypoint, trajectory.size() if
+ * there is none
+ */
+size_t SelfCollision::firstCollision(
+    const std::vector<JointAngles> &trajectory) const noexcept {
+  IncrementalForwardKinematics fk = prototype;
+  for (size_t i = 0; i < trajectory.size(); ++i) {
+    fk.update(trajectory[i]);
+    if ((distances(fk) < radiusSums).any()) {
+      return i;
+    }
+  }
+  return trajectory.size();
+}
+}  // namespace a3c
@@ -0,0 +1,138 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Work-stealing thread pool implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace a3c {
+/**
+ * @brief Construct a new ThreadPool object
+ *
+ * @param numThreads Worker count, 0 means std::thread::hardware_concurrency()
+ */
+ThreadPool::ThreadPool(size_t numThreads) {
+  if (numThreads == 0) {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (size_t i = 0; i < numThreads; ++i) {
+    queues.emplace_back(new WorkerQueue);
+  }
+  for (size_t i = 0; i < numThreads; ++i) {
+    workers.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+/**
+ * @brief Stop and join the workers
+ */
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    stopping = true;
+  }
+  workAvailable.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+/**
+ * @brief Run body over [0, count) on the workers
+ * @note Indices are dealt to the workers in contiguous blocks, then the
+ * workers balance the load by stealing.
+ * @param count Number of tasks
+ * @param body Called once per task index
+ */
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t)> &body) {
+  if (count == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> batchLock(batchMutex);
+  const size_t blockSize = (count + queues.size() - 1) / queues.size();
+  for (size_t q = 0; q < queues.size(); ++q) {
+    std::lock_guard<std::mutex> lock(queues[q]->mutex);
+    for (size_t i = q * blockSize; i < std::min(count, (q + 1) * blockSize);
+         ++i) {
+      queues[q]->tasks.push_back(i);
+    }
+  }
+  std::unique_lock<std::mutex> lock(stateMutex);
+  this->body = &body;
+  pending = count;
+  ++generation;
+  workAvailable.notify_all();
+  // A worker that has not picked up this batch yet must not see body after
+  // the call returns, so wait for the workers to go idle as well
+  batchDone.wait(lock, [this] { return pending == 0 && activeWorkers == 0; });
+  this->body = nullptr;
+}
+
+/**
+ * @brief Pop the worker's own newest task or steal the oldest of another
+ */
+bool ThreadPool::takeTask(size_t self, size_t &task) {
+  {
+    auto &own = *queues[self];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = own.tasks.back();
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+  for (size_t offset = 1; offset < queues.size(); ++offset) {
+    auto &victim = *queues[(self + offset) % queues.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = victim.tasks.front();
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Wait for a batch, drain the queues, report back, repeat
+ */
+void ThreadPool::workerLoop(size_t self) {
+  size_t seenGeneration = 0;
+  for (;;) {
+    const std::function<void(size_t)> *batchBody = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(stateMutex);
+      workAvailable.wait(lock, [&] {
+        return stopping || (generation != seenGeneration && body != nullptr);
+      });
+      if (stopping) {
+        return;
+      }
+      seenGeneration = generation;
+      batchBody = body;
+      ++activeWorkers;
+    }
+    size_t task = 0;
+    size_t completed = 0;
+    while (takeTask(self, task)) {
+      (*batchBody)(task);
+      ++completed;
+    }
+    std::lock_guard<std::mutex> lock(stateMutex);
+    pending -= completed;
+    --activeWorkers;
+    if (pending == 0 && activeWorkers == 0) {
+      batchDone.notify_all();
+    }
+  }
+}
+}  // namespace a3c
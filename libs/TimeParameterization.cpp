@@ -0,0 +1,375 @@
+/**
+ * @file TimeParameterization.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Forward and backward pass time parameterization and sampling
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/TimeParameterization.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace a3c {
+namespace {
+double segmentLength(const JointAngles &a, const JointAngles &b) noexcept {
+  double sum = 0.0;
+  for (size_t j = 0; j < a.size(); ++j) {
+    sum += (b[j] - a[j]) * (b[j] - a[j]);
+  }
+  return std::sqrt(sum);
+}
+
+/**
+ * @brief Grid interval k as q(f) = base + linear f + quadratic f^2 over its
+ * fraction f in [0, 1], see timeParameterize()
+ * @return double Its path length in mean chords
+ */
+double gridInterval(const std::vector<JointAngles> &waypoints, size_t k,
+                    JointAngles &base, JointAngles &linear,
+                    JointAngles &quadratic) noexcept {
+  const size_t last = waypoints.size() - 1;
+  if (k == 0 || k == last) {
+    // Straight from the first waypoint to the midpoint of the first chord,
+    // or from the midpoint of the last chord to the last waypoint
+    const size_t i = k == 0 ? 0 : last - 1;
+    for (size_t j = 0; j < base.size(); ++j) {
+      const double chord = waypoints[i + 1][j] - waypoints[i][j];
+      base[j] = k == 0 ? waypoints[i][j] : waypoints[i][j] + 0.5 * chord;
+      linear[j] = 0.5 * chord;
+      quadratic[j] = 0;
+    }
+    return 0.5;
+  }
+  // The parabola around waypoint k, from the midpoint of the chord before it
+  // to the midpoint of the chord after it
+  for (size_t j = 0; j < base.size(); ++j) {
+    const double previous = waypoints[k][j] - waypoints[k - 1][j];
+    const double chord = waypoints[k + 1][j] - waypoints[k][j];
+    base[j] = waypoints[k - 1][j] + 0.5 * previous;
+    linear[j] = previous;
+    quadratic[j] = 0.5 * (chord - previous);
+  }
+  return 1;
+}
+
+/**
+ * @brief |y - slope x| <= width on the squared path speeds x and y at the
+ * start and end of a grid interval, the limit of one joint at one end
+ */
+struct SpeedBand {
+  double slope;
+  double width;
+};
+// @brief One band per joint and interval end
+constexpr size_t kMaxBands = 2 * std::tuple_size<JointAngles>::value;
+using IntervalBands = std::array<SpeedBand, kMaxBands>;
+
+/**
+ * @brief Acceleration limits of grid interval q(f) = base + linear f +
+ * quadratic f^2 as bands on x and y
+ * @note Over an interval of length ds, q' = (linear + 2 quadratic f) / ds and
+ * q'' = 2 quadratic / ds^2. Joint j accelerates at q'_j a + q''_j x for path
+ * acceleration a and squared path speed x, and the interval's
+ * a = (y - x) / (2 ds). Times 2 ds^2, the limit at the start is
+ * |(4 quadratic - linear) x + linear y| <= 2 ds^2 amax and at the end
+ * |-(linear + 2 quadratic) x + (linear + 6 quadratic) y| <= 2 ds^2 amax. A
+ * limit without a y term only bounds x.
+ * @param highest Lowered to the bounds on x
+ * @return size_t Number of bands written
+ */
+size_t intervalBands(const JointAngles &linear, const JointAngles &quadratic,
+                     const KinematicLimits &limits, double length,
+                     IntervalBands &bands, double &highest) noexcept {
+  const double scale = 2 * length * length;
+  size_t count = 0;
+  auto band = [&](double alpha, double beta, double gamma) {
+    if (beta != 0) {
+      const double inverse = 1 / beta;
+      bands[count++] = {-alpha * inverse, gamma * std::abs(inverse)};
+    } else if (alpha != 0) {
+      highest = std::min(highest, gamma / std::abs(alpha));
+    }
+  };
+  for (size_t j = 0; j < linear.size(); ++j) {
+    const double gamma = scale * limits.maxAcceleration[j];
+    band(4 * quadratic[j] - linear[j], linear[j], gamma);
+    band(-linear[j] - 2 * quadratic[j], linear[j] + 6 * quadratic[j], gamma);
+  }
+  return count;
+}
+
+/**
+ * @brief Highest x from which some y in [0, reachable] is allowed
+ * @note The gap between the highest lower edge of a band and the lowest
+ * upper edge is convex in x and not positive at x = 0, where y = 0 is
+ * allowed, so every x up to its largest root works. Newton steps from highest
+ * approach that root from above without passing it and stop on its line, a
+ * few evaluations per grid point.
+ * @param highest Upper bound on x, e.g. the joint speed limits
+ */
+double highestStart(const IntervalBands &bands, size_t count,
+                    double reachable, double highest) noexcept {
+  double x = std::max(0.0, highest);
+  for (size_t step = 0; step < 2 * kMaxBands; ++step) {
+    double lower = 0;
+    double lowerSlope = 0;
+    double upper = reachable;
+    double upperSlope = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const double center = bands[i].slope * x;
+      if (center + bands[i].width < upper) {
+        upper = center + bands[i].width;
+        upperSlope = bands[i].slope;
+      }
+      if (center - bands[i].width > lower) {
+        lower = center - bands[i].width;
+        lowerSlope = bands[i].slope;
+      }
+    }
+    const double gap = lower - upper;
+    const double slope = lowerSlope - upperSlope;
+    if (!(gap > 0) || !(slope > 0)) {
+      break;
+    }
+    const double next = std::max(0.0, x - gap / slope);
+    if (!(next < x)) {
+      break;
+    }
+    x = next;
+  }
+  return x;
+}
+
+/**
+ * @brief Highest y allowed after x, at most highest
+ * @note When x is at most highestStart() the lower edges stay under this one.
+ */
+double highestEnd(const IntervalBands &bands, size_t count, double x,
+                  double highest) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    highest = std::min(highest, bands[i].slope * x + bands[i].width);
+  }
+  return std::max(0.0, highest);
+}
+}  // namespace
+
+/**
+ * @brief Retime a joint path as fast as the limits allow
+ * @note The arm follows the quadratic B-spline of the waypoints: straight
+ * from the first one to the middle of the first chord, one parabola per inner
+ * waypoint from chord middle to chord middle, then straight to the last
+ * waypoint. The path is tangent continuous, so joint velocity never jumps,
+ * and it cuts each corner by an eighth of the change of chord. The path
+ * parameter s advances by the mean chord length per parabola and by half of
+ * it on either straight end, and the grid points are where the pieces meet.
+ * Along q(s), joint velocity is q' sdot and joint acceleration q' sddot + q''
+ * sdot^2. Within a grid interval q'' is constant and q' and x = sdot^2 change
+ * linearly, so at constant path acceleration the joint acceleration is linear
+ * and within its limits if it is at both ends, see intervalBands(); joint
+ * speed is capped the same way. A backward pass finds the highest x at every
+ * grid point from which the arm can still stop, a forward pass then
+ * accelerates as hard as both ends of each interval allow below it, the time
+ * optimal (bang-bang) profile. Every step is linear in the number of grid
+ * points.
+ * @param path Waypoints, consecutive ones joined by straight segments
+ * @param limits Joint velocity and acceleration limits
+ * @param trajectory Output, the waypoints with grid times and path speeds
+ * @param maxGridStep Longest chord in radians
+ * @return true if limits and maxGridStep are positive and the path is not
+ * empty
+ */
+bool timeParameterize(const std::vector<JointAngles> &path,
+                      const KinematicLimits &limits,
+                      TimedTrajectory &trajectory, double maxGridStep) {
+  for (size_t j = 0; j < limits.maxVelocity.size(); ++j) {
+    if (!(limits.maxVelocity[j] > 0) || !(limits.maxAcceleration[j] > 0)) {
+      return false;
+    }
+  }
+  if (path.empty() || !(maxGridStep > 0)) {
+    return false;
+  }
+  auto &waypoints = trajectory.waypoints;
+  waypoints.clear();
+  waypoints.reserve(path.size());
+  waypoints.push_back(path.front());
+  double totalLength = 0;
+  for (size_t i = 1; i < path.size(); ++i) {
+    const JointAngles from = waypoints.back();
+    const double length = segmentLength(from, path[i]);
+    if (length == 0) {
+      continue;
+    }
+    totalLength += length;
+    if (length <= maxGridStep) {
+      waypoints.push_back(path[i]);
+      continue;
+    }
+    const size_t numSteps =
+        static_cast<size_t>(std::ceil(length / maxGridStep));
+    const double step = 1.0 / numSteps;
+    for (size_t k = 1; k <= numSteps; ++k) {
+      JointAngles q;
+      for (size_t j = 0; j < q.size(); ++j) {
+        q[j] = from[j] + (path[i][j] - from[j]) * (k * step);
+      }
+      waypoints.push_back(q);
+    }
+  }
+  if (waypoints.size() == 1) {
+    trajectory.times.assign(1, 0.0);
+    trajectory.speeds.assign(1, 0.0);
+    return true;
+  }
+  const size_t numIntervals = waypoints.size();
+  trajectory.times.assign(numIntervals + 1, 0.0);
+  trajectory.speeds.assign(numIntervals + 1, 0.0);
+  const double meanChord = totalLength / (waypoints.size() - 1);
+
+  // Squared path speed, at rest on both ends. Backward the highest from which
+  // the arm can still stop, forward as fast as the interval allows below it.
+  auto &x = trajectory.speeds;
+  JointAngles base;
+  JointAngles linear;
+  JointAngles quadratic;
+  JointAngles before;
+  JointAngles beforeQuadratic;
+  IntervalBands bands;
+  for (size_t k = numIntervals - 1; k > 0; --k) {
+    const double beforeLength =
+        meanChord * gridInterval(waypoints, k - 1, base, before,
+                                 beforeQuadratic);
+    const double length =
+        meanChord * gridInterval(waypoints, k, base, linear, quadratic);
+    // Joint speed q'_j sdot: q'_j and x change linearly within an interval,
+    // so x is capped with the tangents of both intervals around the point
+    double highest = std::numeric_limits<double>::infinity();
+    for (size_t j = 0; j < linear.size(); ++j) {
+      const double end = std::abs(linear[j] + 2 * quadratic[j]);
+      const double tangent =
+          std::max(std::abs(before[j]) / beforeLength,
+                   std::max(std::abs(linear[j]), end) / length);
+      const double speed = limits.maxVelocity[j] / tangent;
+      highest = std::min(highest, speed * speed);
+    }
+    const size_t count =
+        intervalBands(linear, quadratic, limits, length, bands, highest);
+    x[k] = highestStart(bands, count, x[k + 1], highest);
+  }
+  for (size_t k = 0; k + 1 < numIntervals; ++k) {
+    const double length =
+        meanChord * gridInterval(waypoints, k, base, linear, quadratic);
+    // x[k] is within the bounds on x from the backward pass
+    double startCap = std::numeric_limits<double>::infinity();
+    const size_t count =
+        intervalBands(linear, quadratic, limits, length, bands, startCap);
+    x[k + 1] = highestEnd(bands, count, x[k], x[k + 1]);
+  }
+
+  for (auto &speed : x) {
+    speed = std::sqrt(speed);
+  }
+  // Constant path acceleration between grid points
+  for (size_t k = 0; k < numIntervals; ++k) {
+    const double length =
+        meanChord * gridInterval(waypoints, k, base, linear, quadratic);
+    double duration = 2 * length / (x[k] + x[k + 1]);
+    if (x[k] + x[k + 1] == 0) {
+      // Jagged paths can force a stop on both ends, cross the interval
+      // accelerating then braking at the limit of a standing start
+      double acceleration = std::numeric_limits<double>::infinity();
+      for (size_t j = 0; j < linear.size(); ++j) {
+        const double tangent = std::max(std::abs(linear[j]),
+                                        std::abs(linear[j] + 2 * quadratic[j]));
+        acceleration = std::min(acceleration,
+                                limits.maxAcceleration[j] * length / tangent);
+      }
+      duration = 2 * std::sqrt(length / acceleration);
+    }
+    trajectory.times[k + 1] = trajectory.times[k] + duration;
+  }
+  return true;
+}
+
+/**
+ * @brief Joint angles at time t
+ * @param t Seconds from the start, clamped to [0, duration()]
+ * @return JointAngles Position on the path at t
+ */
+JointAngles TimedTrajectory::sample(double t) const noexcept {
+  if (t <= 0 || waypoints.size() < 2) {
+    return waypoints.front();
+  }
+  if (t >= duration()) {
+    return waypoints.back();
+  }
+  const size_t k =
+      std::upper_bound(times.begin(), times.end(), t) - times.begin() - 1;
+  return sampleInterval(k, t);
+}
+
+/**
+ * @brief Sample at a fixed rate
+ * @note Walks the grid once, linear in grid points plus samples
+ * @param period Seconds between samples
+ * @return std::vector<JointAngles> Samples at 0, period, 2 period, ... and
+ * the last waypoint
+ */
+std::vector<JointAngles> TimedTrajectory::resample(double period) const {
+  std::vector<JointAngles> samples;
+  if (waypoints.empty() || !(period > 0)) {
+    return samples;
+  }
+  samples.reserve(static_cast<size_t>(duration() / period) + 2);
+  size_t k = 0;
+  for (size_t n = 0; n * period < duration(); ++n) {
+    const double t = n * period;
+    while (times[k + 1] <= t) {
+      ++k;
+    }
+    samples.push_back(sampleInterval(k, t));
+  }
+  samples.push_back(waypoints.back());
+  return samples;
+}
+
+/**
+ * @brief Joint angles in grid interval k, where the path accelerates
+ * uniformly from speeds[k] to speeds[k + 1], or from and to a standstill
+ */
+JointAngles TimedTrajectory::sampleInterval(size_t k,
+                                            double t) const noexcept {
+  const double v0 = speeds[k];
+  const double v1 = speeds[k + 1];
+  const double duration = times[k + 1] - times[k];
+  const double tau = t - times[k];
+  double fraction = 0;
+  if (v0 + v1 > 0) {
+    // Distance covered over interval length, both follow from the speeds
+    fraction = (v0 * tau + 0.5 * (v1 - v0) / duration * tau * tau) /
+               (0.5 * (v0 + v1) * duration);
+  } else {
+    // Standing start and stop, half the interval each
+    const double phase = tau / duration;
+    fraction = phase < 0.5 ? 2 * phase * phase
+                           : 1 - 2 * (1 - phase) * (1 - phase);
+  }
+  fraction = std::min(1.0, std::max(0.0, fraction));
+  JointAngles base;
+  JointAngles linear;
+  JointAngles quadratic;
+  gridInterval(waypoints, k, base, linear, quadratic);
+  JointAngles q;
+  for (size_t j = 0; j < q.size(); ++j) {
+    q[j] = base[j] + (linear[j] + quadratic[j] * fraction) * fraction;
+  }
+  return q;
+}
+}  // namespace a3c
@@ -0,0 +1,176 @@
+/**
+ * @file TrajectoryCompression.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Spline fitting and sampling of joint trajectories
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/TrajectoryCompression.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace a3c {
+namespace {
+/**
+ * @brief Cubic Hermite interpolation between two knots
+ */
+JointAngles hermite(const SplineKnot &start, const SplineKnot &end,
+                    double timeSecs) noexcept {
+  const double span = end.timeSecs - start.timeSecs;
+  const double u = span > 0 ? (timeSecs - start.timeSecs) / span : 0;
+  const double u2 = u * u;
+  const double u3 = u2 * u;
+  const double h00 = 2 * u3 - 3 * u2 + 1;
+  const double h10 = u3 - 2 * u2 + u;
+  const double h01 = -2 * u3 + 3 * u2;
+  const double h11 = u3 - u2;
+  JointAngles angles;
+  for (size_t j = 0; j < angles.size(); ++j) {
+    angles[j] = h00 * start.angles[j] + h10 * span * start.velocities[j] +
+                h01 * end.angles[j] + h11 * span * end.velocities[j];
+  }
+  return angles;
+}
+}  // namespace
+
+/**
+ * @brief Evaluate the spline
+ * @param timeSecs Time from the start of the trajectory
+ * @return JointAngles Interpolated joint angles
+ */
+JointAngles CompressedTrajectory::sample(double timeSecs) const noexcept {
+  if (knots.empty()) {
+    return JointAngles();
+  }
+  if (timeSecs <= knots.front().timeSecs) {
+    return knots.front().angles;
+  }
+  if (timeSecs >= knots.back().timeSecs) {
+    return knots.back().angles;
+  }
+  const auto next = std::upper_bound(
+      knots.begin(), knots.end(), timeSecs,
+      [](double t, const SplineKnot &knot) { return t < knot.timeSecs; });
+  return hermite(*(next - 1), *next, timeSecs);
+}
+
+/**
+ * @brief Sample the spline at a fixed rate
+ * @param timeStepSecs Time between samples
+ * @return std::vector<JointAngles> Waypoints from the first to the last knot
+ */
+std::vector<JointAngles> CompressedTrajectory::resample(
+    double timeStepSecs) const {
+  std::vector<JointAngles> waypoints;
+  if (knots.empty() || !(timeStepSecs > 0)) {
+    return waypoints;
+  }
+  // Rounded so a duration of n steps gives n + 1 samples despite float error
+  const size_t steps =
+      static_cast<size_t>(std::ceil(durationSecs() / timeStepSecs - 1E-9));
+  waypoints.reserve(steps + 1);
+  for (size_t i = 0; i < steps; ++i) {
+    waypoints.push_back(sample(knots.front().timeSecs + i * timeStepSecs));
+  }
+  waypoints.push_back(knots.back().angles);
+  return waypoints;
+}
+
+/**
+ * @brief Knot through waypoint index
+ * @note Central differences inside the trajectory, one sided at the ends
+ */
+SplineKnot TrajectoryCompressor::knotAt(
+    const std::vector<JointAngles> &trajectory, size_t index,
+    double timeStepSecs) noexcept {
+  SplineKnot knot;
+  knot.timeSecs = index * timeStepSecs;
+  knot.angles = trajectory[index];
+  const size_t before = index > 0 ? index - 1 : index;
+  const size_t after = index + 1 < trajectory.size() ? index + 1 : index;
+  const double span = (after - before) * timeStepSecs;
+  for (size_t j = 0; j < knot.velocities.size(); ++j) {
+    knot.velocities[j] =
+        span > 0 ? (trajectory[after][j] - trajectory[before][j]) / span : 0;
+  }
+  return knot;
+}
+
+/**
+ * @brief Check a candidate segment at every original waypoint it covers
+ * @note Joint error first, FK only for waypoints that pass it
+ */
+bool TrajectoryCompressor::segmentFits(
+    const std::vector<JointAngles> &trajectory, const SplineKnot &start,
+    const SplineKnot &end, size_t first, size_t last,
+    double timeStepSecs) const noexcept {
+  for (size_t i = first + 1; i < last; ++i) {
+    const JointAngles angles = hermite(start, end, i * timeStepSecs);
+    for (size_t j = 0; j < angles.size(); ++j) {
+      if (std::abs(angles[j] - trajectory[i][j]) > options.jointTolerance) {
+        return false;
+      }
+    }
+  }
+  for (size_t i = first + 1; i < last; ++i) {
+    const JointAngles angles = hermite(start, end, i * timeStepSecs);
+    const Eigen::Vector3d error = forwardKinematics.fk(angles).position -
+                                  forwardKinematics.fk(trajectory[i]).position;
+    if (error.norm() > options.cartesianTolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Fit a spline within the error bounds
+ * @param trajectory Dense waypoints
+ * @param timeStepSecs Time between waypoints
+ * @return CompressedTrajectory Knots at a subset of the waypoints, always
+ * including the first and the last
+ */
+CompressedTrajectory TrajectoryCompressor::compress(
+    const std::vector<JointAngles> &trajectory, double timeStepSecs) const {
+  std::vector<SplineKnot> knots;
+  if (trajectory.empty()) {
+    return CompressedTrajectory();
+  }
+  const size_t lastIndex = trajectory.size() - 1;
+  size_t current = 0;
+  knots.push_back(knotAt(trajectory, 0, timeStepSecs));
+  while (current < lastIndex) {
+    auto fits = [&](size_t end) {
+      return segmentFits(trajectory, knots.back(),
+                         knotAt(trajectory, end, timeStepSecs), current, end,
+                         timeStepSecs);
+    };
+    // Double the reach while it fits, then bisect between the last fit and
+    // the first failure. A segment to the next waypoint always fits.
+    size_t good = current + 1;
+    size_t step = 1;
+    size_t bad = lastIndex + 1;
+    while (good < lastIndex) {
+      const size_t candidate = std::min(lastIndex, current + 2 * step);
+      if (!fits(candidate)) {
+        bad = candidate;
+        break;
+      }
+      good = candidate;
+      step *= 2;
+    }
+    while (bad - good > 1) {
+      const size_t middle = good + (bad - good) / 2;
+      (fits(middle) ? good : bad) = middle;
+    }
+    current = good;
+    knots.push_back(knotAt(trajectory, current, timeStepSecs));
+  }
+  return CompressedTrajectory(std::move(knots));
+}
+}  // namespace a3c
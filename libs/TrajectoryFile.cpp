@@ -0,0 +1,194 @@
+/**
+ * @file TrajectoryFile.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Trajectory file writer and reader implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include "include/TrajectoryFile.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace a3c {
+namespace {
+constexpr char kMagic[8] = {'A', '3', 'C', 'T', 'R', 'A', 'J', '\0'};
+constexpr uint32_t kVersion = 1;
+static_assert(sizeof(JointAngles) == 6 * sizeof(double),
+              "waypoints are mapped as packed JointAngles");
+static_assert(sizeof(TrajectoryFileHeader) % alignof(double) == 0,
+              "waypoints following the header must stay aligned");
+}  // namespace
+
+/**
+ * @brief Create a trajectory file, a placeholder header is written first
+ * @param path Output file, overwritten
+ * @param fk Arm of the trajectories, its DH hash goes into the header
+ * @param timeStepSecs Time between waypoints
+ * @return true if the file could be created
+ */
+bool TrajectoryWriter::open(const std::string &path,
+                            const ForwardKinematics &fk,
+                            double timeStepSecs) {
+  close();
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.numJoints = ForwardKinematics::mNumDHRows;
+  header.dhHash = fk.dhHash();
+  header.timeStepSecs = timeStepSecs;
+  segmentStarts.clear();
+  out.open(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  return static_cast<bool>(out);
+}
+
+void TrajectoryWriter::beginSegment() {
+  segmentStarts.push_back(header.numWaypoints);
+}
+
+bool TrajectoryWriter::write(const JointAngles &waypoint) {
+  if (segmentStarts.empty()) {
+    beginSegment();
+  }
+  out.write(reinterpret_cast<const char *>(waypoint.data()),
+            sizeof(JointAngles));
+  ++header.numWaypoints;
+  return static_cast<bool>(out);
+}
+
+bool TrajectoryWriter::writeSegment(
+    const std::vector<JointAngles> &trajectory) {
+  beginSegment();
+  out.write(reinterpret_cast<const char *>(trajectory.data()),
+            trajectory.size() * sizeof(JointAngles));
+  header.numWaypoints += trajectory.size();
+  return static_cast<bool>(out);
+}
+
+/**
+ * @brief Stream a generator to the file in fixed size blocks
+ * @param generator Waypoint source, drained
+ * @return size_t Waypoints written
+ */
+size_t TrajectoryWriter::writeSegment(TrajectoryGenerator &generator) {
+  beginSegment();
+  std::array<JointAngles, 256> block;
+  size_t total = 0;
+  size_t count = 0;
+  while (out && (count = generator.fill(block.data(), block.size())) > 0) {
+    out.write(reinterpret_cast<const char *>(block.data()),
+              count * sizeof(JointAngles));
+    total += count;
+  }
+  header.numWaypoints += total;
+  return total;
+}
+
+/**
+ * @brief Finish the file
+ * @return true if every write succeeded
+ */
+bool TrajectoryWriter::close() {
+  if (!out.is_open()) {
+    return true;
+  }
+  header.numSegments = segmentStarts.size();
+  out.write(reinterpret_cast<const char *>(segmentStarts.data()),
+            segmentStarts.size() * sizeof(uint64_t));
+  out.seekp(0);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.flush();
+  const bool ok = static_cast<bool>(out);
+  out.close();
+  return ok;
+}
+
+/**
+ * @brief Map and validate a trajectory file
+ * @param path File written by TrajectoryWriter
+ * @param fk Arm the trajectories must belong to
+ * @return true if the file is complete and matches fk
+ */
+bool TrajectoryReader::open(const std::string &path,
+                            const ForwardKinematics &fk) {
+  close();
+  if (!file.open(path) || file.size() < sizeof(TrajectoryFileHeader)) {
+    close();
+    return false;
+  }
+  header = static_cast<const TrajectoryFileHeader *>(file.data());
+  // Bound the counts first so the size computation cannot wrap around
+  if (header->numWaypoints > file.size() / sizeof(JointAngles) ||
+      header->numSegments > file.size() / sizeof(uint64_t)) {
+    close();
+    return false;
+  }
+  const size_t expectedSize = sizeof(TrajectoryFileHeader) +
+                              header->numWaypoints * sizeof(JointAngles) +
+                              header->numSegments * sizeof(uint64_t);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion ||
+      header->numJoints != ForwardKinematics::mNumDHRows ||
+      header->dhHash != fk.dhHash() || file.size() != expectedSize) {
+    close();
+    return false;
+  }
+  waypoints = reinterpret_cast<const JointAngles *>(header + 1);
+  segmentStarts =
+      reinterpret_cast<const uint64_t *>(waypoints + header->numWaypoints);
+  // Segment starts must be ordered and inside the file
+  uint64_t previous = 0;
+  for (size_t i = 0; i < header->numSegments; ++i) {
+    if (segmentStarts[i] < previous ||
+        segmentStarts[i] > header->numWaypoints) {
+      close();
+      return false;
+    }
+    previous = segmentStarts[i];
+  }
+  return true;
+}
+
+void TrajectoryReader::close() noexcept {
+  file.close();
+  header = nullptr;
+  waypoints = nullptr;
+  segmentStarts = nullptr;
+}
+
+size_t TrajectoryReader::numSegments() const noexcept {
+  return isOpen() ? header->numSegments : 0;
+}
+
+size_t TrajectoryReader::numWaypoints() const noexcept {
+  return isOpen() ? header->numWaypoints : 0;
+}
+
+double TrajectoryReader::timeStepSecs() const noexcept {
+  return isOpen() ? header->timeStepSecs : 0;
+}
+
+TrajectoryView TrajectoryReader::segment(size_t i) const noexcept {
+  TrajectoryView view;
+  if (i >= numSegments()) {
+    return view;
+  }
+  const uint64_t end = i + 1 < header->numSegments ? segmentStarts[i + 1]
+                                                   : header->numWaypoints;
+  view.waypoints = waypoints + segmentStarts[i];
+  view.size = end - segmentStarts[i];
+  return view;
+}
+
+TrajectoryView TrajectoryReader::all() const noexcept {
+  TrajectoryView view;
+  view.waypoints = waypoints;
+  view.size = numWaypoints();
+  return view;
+}
+}  // namespace a3c
@@ -0,0 +1,166 @@
+/**
+ * @file TrajectoryGenerator.cpp
+ * @author Vedant Ranade (vedantr1@umd.edu)
+ * @brief Lazy, step at a time evaluation of linearIK moves
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <cmath>
+
+#include "include/Instrumentation.hpp"
+#include "include/InverseKinematics.hpp"
+
+namespace a3c {
+/**
+ * @brief Construct a new Trajectory Generator object
+ *
+ * @param inIK Solver whose initial joint angles and options are used
+ * @param currentPose Pose of the initial joint angles
+ * @param targetPose Pose to reach in a straight line, its orientation is
+ * slerped to along the way
+ */
+TrajectoryGenerator::TrajectoryGenerator(const InverseKinematics& inIK,
+                                         const Pose& currentPose,
+                                         const Pose& targetPose) noexcept
+    : ik(inIK),
+      startPosition(currentPose.position),
+      endPosition(targetPose.position),
+      startOrientation(currentPose.orientation),
+      endOrientation(targetPose.orientation),
+      setPoint(targetPose),
+      actualPose(currentPose),
+      currentAngles(inIK.initialJointAngles),
+      phi(0),
+      h(1) {
+  A3C_COUNT(kMoves, 1);
+  if (ik.options.integration == IKIntegration::kAdaptive) {
+    actualPose = ik.forwardKinematics.fkWithJacobian(currentAngles,
+                                                     workspace.jacobian);
+  }
+}
+
+/**
+ * @brief Compute the next waypoint
+ * @param waypoint Output, joint angles of the next waypoint
+ * @return false once the target has been reached, waypoint is then untouched
+ */
+bool TrajectoryGenerator::next(JointAngles& waypoint) noexcept {
+  if (done()) {
+    return false;
+  }
+  return ik.options.integration == IKIntegration::kAdaptive
+             ? nextAdaptive(waypoint)
+             : nextFixedStep(waypoint);
+}
+
+/**
+ * @brief Compute up to capacity waypoints into a caller owned buffer
+ * @param waypoints Buffer of at least capacity entries
+ * @param capacity Maximum number of waypoints to compute
+ * @return size_t Number of waypoints written, less than capacity only when
+ * the move is complete
+ */
+size_t TrajectoryGenerator::fill(JointAngles* waypoints,
+                                 size_t capacity) noexcept {
+  size_t count = 0;
+  while (count < capacity && next(waypoints[count])) {
+    ++count;
+  }
+  return count;
+}
+
+/**
+ * @brief Expected number of waypoints of the whole move
+ * @return size_t Exact for kFixedStep, a small initial guess for kAdaptive
+ */
+size_t TrajectoryGenerator::sizeHint() const noexcept {
+  if (ik.options.integration == IKIntegration::kAdaptive) {
+    return 16;
+  }
+  return static_cast<size_t>(std::ceil(1.0 / ik.deltaTimeSecs));
+}
+
+Eigen::Vector3d TrajectoryGenerator::pathPoint(double phi) const noexcept {
+  return ((1 - phi) * startPosition) + (phi * endPosition);
+}
+
+Eigen::Quaterniond TrajectoryGenerator::pathOrientation(
+    double phi) const noexcept {
+  return startOrientation.slerp(phi, endOrientation);
+}
+
+/**
+ * @brief One waypoint per deltaTimeSecs along the straight line
+ */
+bool TrajectoryGenerator::nextFixedStep(JointAngles& waypoint) noexcept {
+  auto dPhi_dt = 1;
+  phi = std::min(1.0, phi + dPhi_dt * ik.deltaTimeSecs);
+  setPoint.position = pathPoint(phi);
+  setPoint.orientation = pathOrientation(phi);
+  ik.step(currentAngles, setPoint, workspace, waypoint);
+  currentAngles = waypoint;
+  return true;
+}
+
+/**
+ * @brief One waypoint per accepted error controlled step
+ * @note Each trial step aims for the path pose phi + h from the measured
+ * pose, then FK checks the end point and the midpoint of the joint increment
+ * against the straight line and the slerped orientation. The error, the
+ * larger of position error / cartesianTolerance and orientation error /
+ * angularTolerance, of a linearized step grows with h^2, so h is rescaled by
+ * sqrt(1 / error): rejected steps shrink, well conditioned stretches take
+ * steps up to the whole remaining move. h never drops below the fixed step of
+ * deltaTimeSecs. The FK pass of an accepted end point also provides the
+ * Jacobian of the next step.
+ */
+bool TrajectoryGenerator::nextAdaptive(JointAngles& waypoint) noexcept {
+  const double tolerance = ik.options.cartesianTolerance;
+  const double angularTolerance = ik.options.angularTolerance;
+  const double minStep = ik.deltaTimeSecs;
+  const auto& fk = ik.forwardKinematics;
+  h = std::min(h, 1 - phi);
+  JointAngles midpoint;
+  double error = 0;
+  for (;;) {
+    setPoint.position = pathPoint(phi + h);
+    setPoint.orientation = pathOrientation(phi + h);
+    ik.stepFrom(currentAngles, actualPose, setPoint, workspace, waypoint);
+    for (size_t i = 0; i < midpoint.size(); i++) {
+      midpoint[i] = currentAngles[i] + 0.5 * workspace.jointDelta[i];
+    }
+    auto midpointPose = fk.fk(midpoint);
+    auto candidatePose = fk.fkWithJacobian(waypoint, candidateJacobian);
+    const double positionError =
+        std::max((candidatePose.position - setPoint.position).norm(),
+                 (midpointPose.position - pathPoint(phi + h / 2)).norm());
+    const double angularError = std::max(
+        candidatePose.orientation.angularDistance(setPoint.orientation),
+        midpointPose.orientation.angularDistance(
+            pathOrientation(phi + h / 2)));
+    error = std::max(positionError / tolerance,
+                     angularError / angularTolerance);
+    if (error <= 1 || h <= minStep) {
+      if (error > 1) {
+        ++violations;
+        A3C_COUNT(kToleranceViolations, 1);
+      }
+      actualPose = candidatePose;
+      break;
+    }
+    A3C_COUNT(kRejectedSteps, 1);
+    h = std::max(minStep, h * std::max(0.2, 0.9 * std::sqrt(1 / error)));
+  }
+  currentAngles = waypoint;
+  workspace.jacobian = candidateJacobian;
+  phi = phi + h >= 1 - minStep * 1E-6 ? 1 : phi + h;
+  const double growth =
+      error > 0 ? std::min(4.0, 0.9 * std::sqrt(1 / error)) : 4.0;
+  h = std::max(minStep, h * growth);
+  return true;
+}
+}  // namespace a3c
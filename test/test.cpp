@@ -1,7 +1,31 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench/AllocationCounter.hpp"
+#include "include/AnalyticalIK.hpp"
+#include "include/BatchPlanner.hpp"
 #include "include/ForwardKinematics.hpp"
+#include "include/IncrementalForwardKinematics.hpp"
+#include "include/Instrumentation.hpp"
 #include "include/InverseKinematics.hpp"
+#include "include/KinematicChain.hpp"
+#include "include/PlanningService.hpp"
+#include "include/PlanningSocket.hpp"
+#include "include/SamplingPlanner.hpp"
+#include "include/SeedIndex.hpp"
+#include "include/SelfCollision.hpp"
+#include "include/TimeParameterization.hpp"
+#include "include/TrajectoryCompression.hpp"
+#include "include/TrajectoryFile.hpp"
 /**
 @brief Test the Forward Kinematics Class for All angles at 0 radians
 */
@@ -90,3 +114,1177 @@ TEST(IK_Test, test_trajectories) {
   EXPECT_NEAR(expectedTargetPose.orientation.w(),
               computedFinalPosition.orientation.w(), 1E-3);
 }
+
+/**
+  @brief Test batched FK against the scalar FK
+  @note Uses a sample count that is not a multiple of the lane count so the
+  partial tail block is covered as well
+*/
+TEST(FK_Test, test_fk_batch) {
+  auto fk = a3c::ForwardKinematics();
+  const Eigen::Index sampleCount = 4 * a3c::ForwardKinematics::mBatchLanes + 3;
+  a3c::JointAnglesBatch batch =
+      M_PI * a3c::JointAnglesBatch::Random(sampleCount, 6);
+  batch.row(0).setZero();
+  a3c::PoseBatch poses;
+  fk.fkBatch(batch, poses);
+  ASSERT_EQ(poses.positions.rows(), sampleCount);
+  for (Eigen::Index i = 0; i < sampleCount; ++i) {
+    a3c::JointAngles ja;
+    for (size_t j = 0; j < ja.size(); ++j) {
+      ja[j] = batch(i, j);
+    }
+    auto pose = fk.fk(ja);
+    for (int k = 0; k < 3; ++k) {
+      EXPECT_NEAR(poses.positions(i, k), pose.position[k], 1E-12);
+    }
+    for (int k = 0; k < 4; ++k) {
+      EXPECT_NEAR(poses.orientations(i, k), pose.orientation.coeffs()[k],
+                  1E-9);
+    }
+  }
+}
+
+/**
+  @brief Test single precision chain, runtime table and batch FK against
+  double FK
+  @note Float kinematics must stay within 0.1 mm over the whole joint range,
+  the tail block of the float batch is covered as well
+*/
+TEST(FK_Test, test_float_kinematics) {
+  const auto fk = a3c::ForwardKinematics();
+  const a3c::A3CChainF chain;
+  const Eigen::Index sampleCount =
+      64 * a3c::ForwardKinematics::mFloatBatchLanes + 5;
+  std::mt19937 rng(19);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  a3c::JointAnglesBatch batch(sampleCount, 6);
+  for (Eigen::Index i = 0; i < sampleCount; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      batch(i, j) = angle(rng);
+    }
+  }
+  a3c::PoseBatchF poses;
+  fk.fkBatch(a3c::JointAnglesBatchF(batch.cast<float>()), poses);
+  ASSERT_EQ(poses.positions.rows(), sampleCount);
+  double worstBatch = 0;
+  double worstChain = 0;
+  double worstJacobian = 0;
+  double worstFk = 0;
+  double worstFkJacobian = 0;
+  for (Eigen::Index i = 0; i < sampleCount; ++i) {
+    a3c::JointAngles ja;
+    a3c::JointAnglesF jaF;
+    for (size_t j = 0; j < ja.size(); ++j) {
+      jaF[j] = static_cast<float>(batch(i, j));
+      // Compare against the float rounded input, not the float arithmetic
+      ja[j] = jaF[j];
+    }
+    a3c::Jacobian expectedJacobian;
+    const auto expected = fk.fkWithJacobian(ja, expectedJacobian);
+    worstBatch = std::max(
+        worstBatch,
+        (poses.positions.row(i).cast<double>().transpose() - expected.position)
+            .norm());
+    a3c::A3CChainF::ChainJacobian jacobian;
+    const auto pose = chain.fkWithJacobian(jaF, jacobian);
+    worstChain = std::max(
+        worstChain, (pose.position.cast<double>() - expected.position).norm());
+    worstJacobian = std::max(
+        worstJacobian,
+        (jacobian.cast<double>() - expectedJacobian).cwiseAbs().maxCoeff());
+    a3c::JacobianF jacobianF;
+    const auto poseF = fk.fkWithJacobian(jaF, jacobianF);
+    EXPECT_EQ(fk.fk(jaF).position, poseF.position);
+    worstFk = std::max(
+        worstFk, (poseF.position.cast<double>() - expected.position).norm());
+    worstFkJacobian = std::max(
+        worstFkJacobian,
+        (jacobianF.cast<double>() - expectedJacobian).cwiseAbs().maxCoeff());
+  }
+  EXPECT_LT(worstBatch, 1E-4);
+  EXPECT_LT(worstChain, 1E-4);
+  EXPECT_LT(worstJacobian, 1E-4);
+  EXPECT_LT(worstFk, 1E-4);
+  EXPECT_LT(worstFkJacobian, 1E-4);
+}
+
+/**
+  @brief Test the fused FK + Jacobian pass
+  @note The pose must match fk() and the linear rows must match a central
+  finite difference of fk() positions
+*/
+TEST(FK_Test, test_fk_with_jacobian) {
+  auto fk = a3c::ForwardKinematics();
+  const a3c::JointAngles ja = {{0.3, -0.7, 1.1, 0.4, -1.2, 2.0}};
+  a3c::Jacobian jacobian;
+  auto pose = fk.fkWithJacobian(ja, jacobian);
+  auto expectedPose = fk.fk(ja);
+  EXPECT_NEAR((pose.position - expectedPose.position).norm(), 0, 1E-12);
+  EXPECT_NEAR(pose.orientation.angularDistance(expectedPose.orientation), 0,
+              1E-9);
+  const double h = 1E-6;
+  for (size_t i = 0; i < ja.size(); ++i) {
+    auto plus = ja;
+    auto minus = ja;
+    plus[i] += h;
+    minus[i] -= h;
+    Eigen::Vector3d numeric =
+        (fk.fk(plus).position - fk.fk(minus).position) / (2 * h);
+    for (int k = 0; k < 3; ++k) {
+      EXPECT_NEAR(jacobian(k, i), numeric[k], 1E-6);
+    }
+  }
+}
+
+/**
+  @brief Test the real time IK step
+  @note Repeated steps must converge on a nearby set-point, and once the
+  workspace exists a step must not allocate
+*/
+TEST(IK_Test, test_step_no_allocations) {
+  const a3c::JointAngles currentAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  const auto ik = a3c::InverseKinematics(currentAngles);
+  auto fk = a3c::ForwardKinematics();
+  auto setPoint = fk.fk(currentAngles);
+  setPoint.position += Eigen::Vector3d(0.002, -0.001, 0.001);
+  a3c::IKWorkspace workspace;
+  auto angles = currentAngles;
+  a3c::JointAngles nextAngles;
+  auto initialError = ik.step(angles, setPoint, workspace, nextAngles);
+  const auto allocationsBefore = a3c::bench::allocationCount();
+  for (int i = 0; i < 10; ++i) {
+    angles = nextAngles;
+    ik.step(angles, setPoint, workspace, nextAngles);
+  }
+  EXPECT_EQ(a3c::bench::allocationCount(), allocationsBefore);
+  EXPECT_GT(initialError, 1E-3);
+  EXPECT_NEAR((fk.fk(nextAngles).position - setPoint.position).norm(), 0,
+              1E-9);
+}
+
+/**
+  @brief Test the IK solver backends
+  @note Both backends agree on a well conditioned pose, next to a singular
+  pose damped least squares keeps the increment bounded
+*/
+TEST(IK_Test, test_solver_backends) {
+  a3c::IKOptions codOptions;
+  codOptions.solver = a3c::IKSolver::kCompleteOrthogonal;
+  a3c::IKOptions dlsOptions;
+  dlsOptions.solver = a3c::IKSolver::kDampedLeastSquares;
+  auto fk = a3c::ForwardKinematics();
+  a3c::IKWorkspace workspace;
+  a3c::JointAngles codAngles;
+  a3c::JointAngles dlsAngles;
+
+  const a3c::JointAngles wellConditioned = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  auto setPoint = fk.fk(wellConditioned);
+  setPoint.position += Eigen::Vector3d(0.001, 0.001, -0.001);
+  a3c::InverseKinematics(wellConditioned, codOptions)
+      .step(wellConditioned, setPoint, workspace, codAngles);
+  a3c::InverseKinematics(wellConditioned, dlsOptions)
+      .step(wellConditioned, setPoint, workspace, dlsAngles);
+  for (size_t i = 0; i < codAngles.size(); ++i) {
+    EXPECT_NEAR(codAngles[i], dlsAngles[i], 1E-9);
+  }
+
+  // Arm almost stretched straight up, then asked to move along the axis it
+  // cannot move along
+  const a3c::JointAngles nearSingular = {{0, 0, 1E-6, 0, 1E-6, 0}};
+  setPoint = fk.fk(nearSingular);
+  setPoint.position.z() += 0.001;
+  a3c::InverseKinematics(nearSingular, codOptions)
+      .step(nearSingular, setPoint, workspace, codAngles);
+  a3c::InverseKinematics(nearSingular, dlsOptions)
+      .step(nearSingular, setPoint, workspace, dlsAngles);
+  double codIncrement = 0;
+  double dlsIncrement = 0;
+  for (size_t i = 0; i < codAngles.size(); ++i) {
+    codIncrement = std::max(codIncrement, std::abs(codAngles[i]));
+    dlsIncrement = std::max(dlsIncrement, std::abs(dlsAngles[i]));
+  }
+  EXPECT_LT(dlsIncrement, 0.1);
+  EXPECT_GT(codIncrement, 10 * dlsIncrement);
+}
+
+/**
+  @brief Test adaptive integration of linearIK
+  @note A short move takes a handful of steps, a long one far fewer than the
+  fixed step's 1000, and every waypoint stays within the tolerance of the line.
+  A tolerance the minimum step cannot meet is reported, not hidden.
+*/
+TEST(IK_Test, test_adaptive_linear_ik) {
+  const a3c::JointAngles currentAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  a3c::IKOptions options;
+  options.integration = a3c::IKIntegration::kAdaptive;
+  options.cartesianTolerance = 1E-4;
+  auto ik = a3c::InverseKinematics(currentAngles, options);
+  auto fk = a3c::ForwardKinematics();
+  const auto currentPose = fk.fk(currentAngles);
+  for (const Eigen::Vector3d &delta :
+       {Eigen::Vector3d(0.001, 0, 0), Eigen::Vector3d(-0.2, -0.01, 0.001)}) {
+    auto targetPose = currentPose;
+    targetPose.position += delta;
+    auto jointTrajectory = ik.linearIK(currentPose, targetPose);
+    ASSERT_FALSE(jointTrajectory.empty());
+    EXPECT_LT(jointTrajectory.size(), delta.norm() > 0.01 ? 200 : 5);
+    for (const auto &ja : jointTrajectory) {
+      Eigen::Vector3d position = fk.fk(ja).position;
+      double along = (position - currentPose.position).dot(delta.normalized());
+      Eigen::Vector3d closest =
+          currentPose.position + along * delta.normalized();
+      EXPECT_LT((position - closest).norm(), options.cartesianTolerance);
+    }
+    auto finalPose = fk.fk(jointTrajectory.back());
+    EXPECT_LT((finalPose.position - targetPose.position).norm(),
+              options.cartesianTolerance);
+    EXPECT_LT(finalPose.orientation.angularDistance(targetPose.orientation),
+              1E-2);
+    auto generator = ik.linearTrajectory(currentPose, targetPose);
+    a3c::JointAngles waypoint;
+    while (generator.next(waypoint)) {
+    }
+    EXPECT_EQ(generator.toleranceViolations(), 0u);
+  }
+  options.cartesianTolerance = 1E-12;
+  auto strictIK = a3c::InverseKinematics(currentAngles, options);
+  auto targetPose = currentPose;
+  targetPose.position.x() -= 0.01;
+  auto generator = strictIK.linearTrajectory(currentPose, targetPose);
+  a3c::JointAngles waypoint;
+  while (generator.next(waypoint)) {
+  }
+  EXPECT_TRUE(generator.done());
+  EXPECT_GT(generator.toleranceViolations(), 0u);
+}
+
+/**
+  @brief Test full pose tracking in linearIK
+  @note A move that also turns the tool 30 degrees must follow the line and
+  the slerped orientation at every waypoint and end on the target pose, with
+  the fixed step and the adaptive integration
+*/
+TEST(IK_Test, test_orientation_tracking) {
+  const a3c::JointAngles currentAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  auto fk = a3c::ForwardKinematics();
+  const auto currentPose = fk.fk(currentAngles);
+  auto targetPose = currentPose;
+  targetPose.position += Eigen::Vector3d(0.03, -0.02, 0.01);
+  targetPose.orientation =
+      Eigen::AngleAxisd(M_PI / 6, Eigen::Vector3d(1, 1, 0).normalized()) *
+      currentPose.orientation;
+  const Eigen::Quaterniond q(0.9, 0.1, -0.3, 0.2);
+  EXPECT_NEAR(a3c::orientationError(q.normalized(), q.normalized()).norm(),
+              0, 1E-12);
+  EXPECT_NEAR(
+      a3c::orientationError(currentPose.orientation, targetPose.orientation)
+          .norm(),
+      M_PI / 6, 1E-9);
+
+  for (const auto integration :
+       {a3c::IKIntegration::kFixedStep, a3c::IKIntegration::kAdaptive}) {
+    a3c::IKOptions options;
+    options.integration = integration;
+    auto ik = a3c::InverseKinematics(currentAngles, options);
+    const auto jointTrajectory = ik.linearIK(currentPose, targetPose);
+    ASSERT_FALSE(jointTrajectory.empty());
+    const Eigen::Vector3d delta = targetPose.position - currentPose.position;
+    for (const auto &ja : jointTrajectory) {
+      const auto pose = fk.fk(ja);
+      const double phi =
+          (pose.position - currentPose.position).dot(delta) /
+          delta.squaredNorm();
+      const Eigen::Vector3d closest = currentPose.position + phi * delta;
+      EXPECT_LT((pose.position - closest).norm(), 1E-3);
+      EXPECT_LT(pose.orientation.angularDistance(currentPose.orientation.slerp(
+                    std::min(1.0, std::max(0.0, phi)), targetPose.orientation)),
+                1E-2);
+    }
+    const auto finalPose = fk.fk(jointTrajectory.back());
+    EXPECT_LT((finalPose.position - targetPose.position).norm(), 1E-4);
+    EXPECT_LT(finalPose.orientation.angularDistance(targetPose.orientation),
+              1E-3);
+  }
+}
+
+/**
+  @brief Test the lazy trajectory generator
+  @note Waypoints pulled one at a time, through fill() and through iterators
+  must all match linearIK
+*/
+TEST(IK_Test, test_trajectory_generator) {
+  const a3c::JointAngles currentAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  auto ik = a3c::InverseKinematics(currentAngles);
+  auto fk = a3c::ForwardKinematics();
+  const auto currentPose = fk.fk(currentAngles);
+  auto targetPose = currentPose;
+  targetPose.position += Eigen::Vector3d(0.05, 0.02, -0.03);
+  const auto expected = ik.linearIK(currentPose, targetPose);
+
+  auto generator = ik.linearTrajectory(currentPose, targetPose);
+  EXPECT_EQ(generator.sizeHint(), expected.size());
+  a3c::JointAngles first;
+  ASSERT_TRUE(generator.next(first));
+  EXPECT_EQ(first, expected.front());
+  // Drain the rest through a small ring buffer
+  std::array<a3c::JointAngles, 64> ring;
+  size_t produced = 1;
+  size_t written = 0;
+  while ((written = generator.fill(ring.data(), ring.size())) > 0) {
+    for (size_t i = 0; i < written; ++i) {
+      EXPECT_EQ(ring[i], expected[produced + i]);
+    }
+    produced += written;
+  }
+  EXPECT_EQ(produced, expected.size());
+  EXPECT_TRUE(generator.done());
+
+  size_t index = 0;
+  for (const auto &ja : ik.linearTrajectory(currentPose, targetPose)) {
+    ASSERT_LT(index, expected.size());
+    EXPECT_EQ(ja, expected[index++]);
+  }
+  EXPECT_EQ(index, expected.size());
+}
+
+/**
+  @brief Test the analytical IK
+  @note Every returned solution must reproduce the pose, and the configuration
+  the pose came from must be among them
+*/
+TEST(IK_Test, test_analytical_ik) {
+  auto fk = a3c::ForwardKinematics();
+  const a3c::AnalyticalIK analyticalIK(fk);
+  std::mt19937 rng(8);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  int recovered = 0;
+  const int kSamples = 200;
+  for (int sample = 0; sample < kSamples; ++sample) {
+    a3c::JointAngles original;
+    for (auto &q : original) {
+      q = angle(rng);
+    }
+    const auto pose = fk.fk(original);
+    a3c::IKSolutions result;
+    analyticalIK.solve(pose, result);
+    for (size_t i = 0; i < result.count; ++i) {
+      const auto solved = fk.fk(result.solutions[i]);
+      EXPECT_LT((solved.position - pose.position).norm(), 1E-6);
+      EXPECT_LT(solved.orientation.angularDistance(pose.orientation), 1E-6);
+    }
+    a3c::JointAngles closest;
+    if (analyticalIK.solveClosest(pose, original, closest)) {
+      double distance = 0;
+      for (size_t j = 0; j < original.size(); ++j) {
+        distance = std::max(distance, std::abs(closest[j] - original[j]));
+      }
+      recovered += distance < 1E-5;
+    }
+  }
+  EXPECT_EQ(recovered, kSamples);
+}
+
+/**
+  @brief Test sharing one FK and one IK instance between threads
+  @note Every thread repeats the same queries on the same const objects, the
+  results must be bit identical to the single threaded ones
+*/
+TEST(IK_Test, test_concurrent_kinematics) {
+  const auto fk = a3c::ForwardKinematics();
+  const a3c::JointAngles currentAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  const auto ik = a3c::InverseKinematics(currentAngles);
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  std::vector<a3c::JointAngles> samples(64);
+  for (auto &ja : samples) {
+    for (auto &q : ja) {
+      q = angle(rng);
+    }
+  }
+  std::vector<a3c::Pose, Eigen::aligned_allocator<a3c::Pose>> expectedPoses;
+  std::vector<a3c::Jacobian, Eigen::aligned_allocator<a3c::Jacobian>>
+      expectedJacobians(samples.size());
+  for (size_t i = 0; i < samples.size(); ++i) {
+    expectedPoses.push_back(fk.fk(samples[i]));
+    fk.fkWithJacobian(samples[i], expectedJacobians[i]);
+  }
+  const auto currentPose = fk.fk(currentAngles);
+  auto targetPose = currentPose;
+  targetPose.position += Eigen::Vector3d(0.005, -0.005, 0.005);
+  const auto expectedTrajectory = ik.linearIK(currentPose, targetPose);
+
+  std::atomic<int> mismatches{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; ++t) {
+    workers.emplace_back([&] {
+      a3c::Jacobian jacobian;
+      for (int round = 0; round < 20; ++round) {
+        for (size_t i = 0; i < samples.size(); ++i) {
+          const auto pose = fk.fk(samples[i]);
+          fk.fkWithJacobian(samples[i], jacobian);
+          mismatches += pose.position != expectedPoses[i].position ||
+                        pose.orientation.coeffs() !=
+                            expectedPoses[i].orientation.coeffs() ||
+                        jacobian != expectedJacobians[i];
+        }
+      }
+      mismatches += ik.linearIK(currentPose, targetPose) != expectedTrajectory;
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_EQ(fk.fk(samples.front()).position, expectedPoses.front().position);
+}
+
+/**
+  @brief Test the parallel batch planner
+  @note Results must come back in job order, equal to planning each job alone,
+  and a target out of reach in position or orientation must be reported
+  instead of returned as success
+*/
+TEST(IK_Test, test_batch_planner) {
+  const a3c::JointAngles nominalAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  const auto fk = a3c::ForwardKinematics();
+  std::mt19937 rng(10);
+  std::uniform_real_distribution<double> perturbation(-0.2, 0.2);
+  a3c::PlanJobs jobs;
+  for (int i = 0; i < 12; ++i) {
+    auto startAngles = nominalAngles;
+    for (auto &q : startAngles) {
+      q += perturbation(rng);
+    }
+    const auto currentPose = fk.fk(startAngles);
+    auto targetPose = currentPose;
+    targetPose.position +=
+        Eigen::Vector3d(perturbation(rng), perturbation(rng), 0) * 0.02;
+    jobs.push_back({startAngles, currentPose, targetPose});
+  }
+  // Two metres away, beyond the reach of the arm
+  auto unreachable = jobs.front();
+  unreachable.targetPose.position += Eigen::Vector3d(2, 0, 0);
+  jobs.push_back(unreachable);
+
+  a3c::BatchPlanner planner(a3c::IKOptions(), 3);
+  EXPECT_EQ(planner.numThreads(), 3u);
+  const auto results = planner.plan(jobs);
+  ASSERT_EQ(results.size(), jobs.size());
+  for (size_t i = 0; i + 1 < jobs.size(); ++i) {
+    const a3c::InverseKinematics ik(jobs[i].startAngles);
+    EXPECT_EQ(results[i].status, a3c::PlanStatus::kSuccess);
+    EXPECT_EQ(results[i].trajectory,
+              ik.linearIK(jobs[i].currentPose, jobs[i].targetPose));
+  }
+  EXPECT_NE(results.back().status, a3c::PlanStatus::kSuccess);
+  // The position is reached, but not the orientation within a tolerance no
+  // fixed step solve meets
+  a3c::IKOptions strict;
+  strict.angularTolerance = 1E-15;
+  const auto misaligned = a3c::planJob(jobs.front(), strict, 1E-3, fk);
+  EXPECT_LE(misaligned.goalError, 1E-3);
+  EXPECT_EQ(misaligned.status, a3c::PlanStatus::kGoalNotReached);
+  // The pool is reused for the next batch
+  EXPECT_EQ(planner.plan(jobs).front().trajectory, results.front().trajectory);
+  EXPECT_TRUE(planner.plan(a3c::PlanJobs()).empty());
+}
+
+namespace {
+// @brief Planar 3R arm with 0.4 m and 0.3 m links, the last frame at the wrist
+struct PlanarDescription {
+  constexpr static const size_t mNumJoints = 3;
+  static constexpr std::array<a3c::DHRow, mNumJoints> dhTable() {
+    return {{{0, 0, 0, 0}, {0, 0.4, 0, 0}, {0, 0.3, 0, 0}}};
+  }
+};
+}  // namespace
+
+/**
+  @brief Test the compile time specialized chain
+  @note The A3C chain must match the runtime ForwardKinematics, and a second
+  description must give the closed form planar FK and Jacobian without any
+  robot specific code
+*/
+TEST(FK_Test, test_kinematic_chain) {
+  const a3c::A3CChain chain;
+  const auto fk = a3c::ForwardKinematics();
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  for (int sample = 0; sample < 100; ++sample) {
+    a3c::JointAngles ja;
+    for (auto &q : ja) {
+      q = angle(rng);
+    }
+    a3c::Jacobian expectedJacobian;
+    const auto expected = fk.fkWithJacobian(ja, expectedJacobian);
+    a3c::A3CChain::ChainJacobian jacobian;
+    const auto pose = chain.fkWithJacobian(ja, jacobian);
+    EXPECT_TRUE(pose.position.isApprox(expected.position, 1E-12));
+    EXPECT_LT(pose.orientation.angularDistance(expected.orientation), 1E-12);
+    EXPECT_TRUE(jacobian.isApprox(expectedJacobian, 1E-12));
+    EXPECT_TRUE(chain.fk(ja).position.isApprox(expected.position, 1E-12));
+  }
+
+  const a3c::KinematicChain<PlanarDescription> planar;
+  const std::array<double, 3> q = {{0.3, -0.7, 1.1}};
+  a3c::KinematicChain<PlanarDescription>::ChainJacobian jacobian;
+  const auto pose = planar.fkWithJacobian(q, jacobian);
+  const double x = 0.4 * std::cos(q[0]) + 0.3 * std::cos(q[0] + q[1]);
+  const double y = 0.4 * std::sin(q[0]) + 0.3 * std::sin(q[0] + q[1]);
+  EXPECT_NEAR(pose.position.x(), x, 1E-12);
+  EXPECT_NEAR(pose.position.y(), y, 1E-12);
+  EXPECT_NEAR(pose.position.z(), 0, 1E-12);
+  EXPECT_NEAR(jacobian(0, 0), -y, 1E-12);
+  EXPECT_NEAR(jacobian(1, 0), x, 1E-12);
+  EXPECT_NEAR(jacobian(0, 1), -0.3 * std::sin(q[0] + q[1]), 1E-12);
+  EXPECT_NEAR(jacobian(1, 2), 0, 1E-12);
+  EXPECT_NEAR(jacobian(5, 2), 1, 1E-12);
+}
+
+/**
+  @brief Test incremental FK
+  @note After any sequence of partial updates the pose and every link frame
+  must match a full FK pass
+*/
+TEST(FK_Test, test_incremental_fk) {
+  const auto fk = a3c::ForwardKinematics();
+  a3c::IncrementalForwardKinematics incremental(fk);
+  std::mt19937 rng(12);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  std::uniform_int_distribution<size_t> firstChanged(0, 5);
+  a3c::JointAngles ja = incremental.jointAngles();
+  EXPECT_EQ(incremental.update(ja),
+            a3c::IncrementalForwardKinematics::mNumLinks);
+  for (int sample = 0; sample < 100; ++sample) {
+    const size_t first = firstChanged(rng);
+    for (size_t i = first; i < ja.size(); ++i) {
+      ja[i] = angle(rng);
+    }
+    EXPECT_EQ(incremental.update(ja), first);
+    const auto expected = fk.fk(ja);
+    const auto pose = incremental.pose();
+    EXPECT_TRUE(pose.position.isApprox(expected.position, 1E-12));
+    EXPECT_LT(pose.orientation.angularDistance(expected.orientation), 1E-12);
+
+    Matrix4d T = Matrix4d::Identity();
+    const auto &dh = fk.getDHTable();
+    for (size_t i = 0; i < ja.size(); ++i) {
+      Eigen::Array<double, 1, 4> dhRow = dh.row(i);
+      dhRow(a3c::ForwardKinematics::thetaIndex) += ja[i];
+      T *= fk.getTransformationMatrix(dhRow);
+      const auto &frame = incremental.linkFrame(i + 1);
+      EXPECT_TRUE(frame.origin.isApprox(T.block<3, 1>(0, 3), 1E-12));
+      EXPECT_TRUE(frame.rotation.isApprox(T.topLeftCorner<3, 3>(), 1E-12));
+    }
+  }
+}
+
+/**
+  @brief Test the memory mapped seed index
+  @note A stored sample must be found exactly, seeds of other poses must be
+  close, and files that are missing, truncated, built for another arm or
+  whose header counts overflow the size check must be rejected
+*/
+TEST(IK_Test, test_seed_index) {
+  const auto fk = a3c::ForwardKinematics();
+  const std::string path = ::testing::TempDir() + "a3c-seed-index.bin";
+  a3c::SeedIndexOptions options;
+  options.numSamples = 20000;
+  ASSERT_TRUE(a3c::SeedIndex::build(path, fk, options));
+  a3c::SeedIndex index;
+  ASSERT_TRUE(index.open(path, fk));
+  EXPECT_EQ(index.numEntries(), options.numSamples);
+
+  // The first sample the builder drew
+  std::mt19937_64 builderRng(options.randomSeed);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  a3c::JointAngles stored;
+  for (auto &q : stored) {
+    q = angle(builderRng);
+  }
+  a3c::JointAngles seed;
+  ASSERT_TRUE(index.nearestSeed(fk.fk(stored), seed));
+  EXPECT_EQ(seed, stored);
+  EXPECT_TRUE(index.isReachable(fk.fk(stored).position));
+  EXPECT_FALSE(index.isReachable(Eigen::Vector3d(2, 2, 2)));
+
+  std::mt19937 rng(13);
+  for (int sample = 0; sample < 20; ++sample) {
+    a3c::JointAngles ja;
+    for (auto &q : ja) {
+      q = angle(rng);
+    }
+    const auto target = fk.fk(ja);
+    ASSERT_TRUE(index.nearestSeed(target, seed));
+    EXPECT_LT((fk.fk(seed).position - target.position).norm(), 0.1);
+  }
+
+  a3c::ForwardKinematics::DHTable otherTable = fk.getDHTable();
+  otherTable(2, a3c::ForwardKinematics::aIndex) += 0.01;
+  EXPECT_FALSE(index.open(path, a3c::ForwardKinematics(otherTable)));
+  EXPECT_FALSE(index.isOpen());
+  EXPECT_FALSE(index.nearestSeed(fk.fk(stored), seed));
+  EXPECT_FALSE(index.open(path + ".missing", fk));
+
+  // numEntries follows magic, version, reserved and dhHash, 2^61 extra
+  // 104 byte entries add a multiple of 2^64 bytes to the expected size
+  {
+    std::fstream stream(path, std::ios::in | std::ios::out | std::ios::binary);
+    uint64_t numEntries = 0;
+    stream.seekg(24);
+    stream.read(reinterpret_cast<char *>(&numEntries), sizeof(numEntries));
+    const uint64_t overflowing = numEntries + (uint64_t{1} << 61);
+    stream.seekp(24);
+    stream.write(reinterpret_cast<const char *>(&overflowing),
+                 sizeof(overflowing));
+    stream.close();
+    EXPECT_FALSE(index.open(path, fk));
+    stream.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    stream.seekp(24);
+    stream.write(reinterpret_cast<const char *>(&numEntries),
+                 sizeof(numEntries));
+  }
+  ASSERT_TRUE(index.open(path, fk));
+  index.close();
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size() / 2);
+  }
+  EXPECT_FALSE(index.open(path, fk));
+  std::remove(path.c_str());
+}
+
+/**
+  @brief Test capsule self-collision
+  @note The vectorized clearance must match a dense scan of the link segments,
+  and a trajectory folding the forearm onto the upper arm must be stopped at
+  its first colliding waypoint
+*/
+TEST(FK_Test, test_self_collision) {
+  const auto fk = a3c::ForwardKinematics();
+  const a3c::CapsuleModel model;
+  const a3c::SelfCollision checker(fk, model);
+  a3c::IncrementalForwardKinematics frames(fk);
+  std::mt19937 rng(14);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  for (int sample = 0; sample < 8; ++sample) {
+    a3c::JointAngles ja;
+    for (auto &q : ja) {
+      q = angle(rng);
+    }
+    frames.update(ja);
+    double expected = std::numeric_limits<double>::infinity();
+    for (size_t k = 0; k < a3c::SelfCollision::mNumPairs; ++k) {
+      const auto pair = checker.pair(k);
+      const auto &p1 = frames.linkFrame(pair.first).origin;
+      const auto &q1 = frames.linkFrame(pair.first + 1).origin;
+      const auto &p2 = frames.linkFrame(pair.second).origin;
+      const auto &q2 = frames.linkFrame(pair.second + 1).origin;
+      const int kSteps = 100;
+      double distance = std::numeric_limits<double>::infinity();
+      for (int i = 0; i <= kSteps; ++i) {
+        for (int j = 0; j <= kSteps; ++j) {
+          const Eigen::Vector3d c1 = p1 + (q1 - p1) * i / kSteps;
+          const Eigen::Vector3d c2 = p2 + (q2 - p2) * j / kSteps;
+          distance = std::min(distance, (c1 - c2).norm());
+        }
+      }
+      expected = std::min(expected, distance - model.radii[pair.first] -
+                                        model.radii[pair.second]);
+    }
+    const double clearance = checker.clearance(ja);
+    EXPECT_LE(clearance, expected + 1E-9);
+    EXPECT_NEAR(clearance, expected, 3E-3);
+  }
+
+  const a3c::JointAngles nominalAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  EXPECT_FALSE(checker.inCollision(nominalAngles));
+  std::vector<a3c::JointAngles> trajectory;
+  for (int i = 0; i <= 1000; ++i) {
+    trajectory.push_back({{0, 0, 3.0 * i / 1000, 0, 0, 0}});
+  }
+  const size_t first = checker.firstCollision(trajectory);
+  ASSERT_LT(first, trajectory.size());
+  ASSERT_GT(first, 0u);
+  EXPECT_TRUE(checker.inCollision(trajectory[first]));
+  for (size_t i = 0; i < first; ++i) {
+    EXPECT_FALSE(checker.inCollision(trajectory[i]));
+  }
+  trajectory.resize(first);
+  EXPECT_EQ(checker.firstCollision(trajectory), trajectory.size());
+}
+
+/**
+  @brief Test spline compression of a linearIK trajectory
+  @note Resampled at the original rate every waypoint must be within the
+  joint and Cartesian bounds, with an order of magnitude fewer bytes
+*/
+TEST(IK_Test, test_trajectory_compression) {
+  const a3c::JointAngles currentAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  const auto ik = a3c::InverseKinematics(currentAngles);
+  const auto fk = a3c::ForwardKinematics();
+  const auto currentPose = fk.fk(currentAngles);
+  auto targetPose = currentPose;
+  targetPose.position += Eigen::Vector3d(0.1, -0.05, 0.08);
+  const auto trajectory = ik.linearIK(currentPose, targetPose);
+
+  a3c::CompressionOptions options;
+  const a3c::TrajectoryCompressor compressor(options);
+  const auto compressed = compressor.compress(trajectory, 0.001);
+  EXPECT_LE(compressed.byteSize() * 10,
+            trajectory.size() * sizeof(a3c::JointAngles));
+  EXPECT_NEAR(compressed.durationSecs(), (trajectory.size() - 1) * 0.001,
+              1E-12);
+
+  const auto resampled = compressed.resample(0.001);
+  ASSERT_EQ(resampled.size(), trajectory.size());
+  EXPECT_EQ(resampled.front(), trajectory.front());
+  EXPECT_EQ(resampled.back(), trajectory.back());
+  for (size_t i = 0; i < trajectory.size(); ++i) {
+    for (size_t j = 0; j < trajectory[i].size(); ++j) {
+      EXPECT_LE(std::abs(resampled[i][j] - trajectory[i][j]),
+                options.jointTolerance);
+    }
+    EXPECT_LE((fk.fk(resampled[i]).position - fk.fk(trajectory[i]).position)
+                  .norm(),
+              options.cartesianTolerance);
+  }
+  // Any other rate, e.g. a 250 Hz controller
+  EXPECT_EQ(compressed.resample(0.004).size(),
+            (trajectory.size() - 1 + 3) / 4 + 1);
+  EXPECT_TRUE(compressor.compress({}).resample(0.001).empty());
+}
+
+/**
+  @brief Test the binary trajectory file round trip
+  @note A vector segment and a streamed generator segment must read back
+  bit identical, unfinished files, files of another arm and headers whose
+  counts overflow the size check must be rejected
+*/
+TEST(IK_Test, test_trajectory_file) {
+  const a3c::JointAngles currentAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  const auto ik = a3c::InverseKinematics(currentAngles);
+  const auto fk = a3c::ForwardKinematics();
+  const auto currentPose = fk.fk(currentAngles);
+  auto targetPose = currentPose;
+  targetPose.position += Eigen::Vector3d(0.02, 0.01, -0.01);
+  const auto trajectory = ik.linearIK(currentPose, targetPose);
+
+  const std::string path = ::testing::TempDir() + "a3c-trajectories.bin";
+  a3c::TrajectoryWriter writer;
+  ASSERT_TRUE(writer.open(path, fk, 0.001));
+  EXPECT_TRUE(writer.writeSegment(trajectory));
+  auto generator = ik.linearTrajectory(currentPose, targetPose);
+  EXPECT_EQ(writer.writeSegment(generator), trajectory.size());
+  writer.beginSegment();
+  EXPECT_TRUE(writer.write(currentAngles));
+
+  a3c::TrajectoryReader reader;
+  // Header and segment table are only written on close
+  EXPECT_FALSE(reader.open(path, fk));
+  ASSERT_TRUE(writer.close());
+  ASSERT_TRUE(reader.open(path, fk));
+  EXPECT_EQ(reader.numSegments(), 3u);
+  EXPECT_EQ(reader.numWaypoints(), 2 * trajectory.size() + 1);
+  EXPECT_EQ(reader.timeStepSecs(), 0.001);
+  for (size_t s = 0; s < 2; ++s) {
+    const auto segment = reader.segment(s);
+    ASSERT_EQ(segment.size, trajectory.size());
+    EXPECT_TRUE(std::equal(segment.begin(), segment.end(), trajectory.begin()));
+  }
+  ASSERT_EQ(reader.segment(2).size, 1u);
+  EXPECT_EQ(reader.segment(2)[0], currentAngles);
+  EXPECT_EQ(reader.segment(3).size, 0u);
+  EXPECT_EQ(reader.all().size, reader.numWaypoints());
+
+  a3c::ForwardKinematics::DHTable otherTable = fk.getDHTable();
+  otherTable(0, a3c::ForwardKinematics::dIndex) += 0.01;
+  EXPECT_FALSE(reader.open(path, a3c::ForwardKinematics(otherTable)));
+  EXPECT_EQ(reader.numWaypoints(), 0u);
+
+  // 2^60 extra waypoints add a multiple of 2^64 bytes to the expected size
+  a3c::TrajectoryFileHeader header;
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  header.numWaypoints += uint64_t{1} << 60;
+  file.seekp(0);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.close();
+  EXPECT_FALSE(reader.open(path, fk));
+  std::remove(path.c_str());
+}
+
+/**
+ * @brief Test the hot path instrumentation snapshot and its JSON export
+ * @note Without WANT_INSTRUMENTATION the probes compile out and every count
+ * must stay zero, with it a linearIK move must show up in the totals
+ */
+TEST(IK_Test, test_instrumentation) {
+  const a3c::JointAngles currentAngles = {{0.3, -0.6, 0.9, 0.2, 0.7, 0.1}};
+  const auto ik = a3c::InverseKinematics(currentAngles);
+  const auto fk = a3c::ForwardKinematics();
+  const auto currentPose = fk.fk(currentAngles);
+  auto targetPose = currentPose;
+  targetPose.position += Eigen::Vector3d(0.01, 0, 0);
+
+  a3c::resetInstrumentation();
+  const auto trajectory = ik.linearIK(currentPose, targetPose);
+  const auto snapshot = a3c::instrumentationSnapshot();
+  const auto index = [](a3c::Counter counter) {
+    return static_cast<size_t>(counter);
+  };
+  const auto linearIK = static_cast<size_t>(a3c::Probe::kLinearIK);
+  uint64_t conditions = 0;
+  for (auto n : snapshot.conditionHistogram) {
+    conditions += n;
+  }
+#ifdef A3C_INSTRUMENTATION
+  EXPECT_TRUE(snapshot.enabled);
+  EXPECT_EQ(snapshot.calls[linearIK], 1u);
+  EXPECT_GT(snapshot.cycles[linearIK], 0u);
+  EXPECT_EQ(snapshot.counters[index(a3c::Counter::kMoves)], 1u);
+  EXPECT_EQ(snapshot.counters[index(a3c::Counter::kSteps)], trajectory.size());
+  EXPECT_EQ(snapshot.counters[index(a3c::Counter::kVectorGrowth)], 0u);
+  EXPECT_EQ(conditions, trajectory.size());
+#else
+  EXPECT_FALSE(snapshot.enabled);
+  EXPECT_EQ(snapshot.calls[linearIK], 0u);
+  EXPECT_EQ(snapshot.counters[index(a3c::Counter::kSteps)], 0u);
+  EXPECT_EQ(conditions, 0u);
+#endif
+  const std::string json = a3c::toJson(snapshot);
+  EXPECT_NE(json.find("\"linear_ik\": {\"calls\": "), std::string::npos);
+  EXPECT_NE(json.find("\"steps\": "), std::string::npos);
+  EXPECT_NE(json.find("\"condition_histogram\": ["), std::string::npos);
+}
+
+namespace {
+// @brief A 20 mm move from a perturbed, well conditioned configuration
+a3c::PlanJob smallMove(std::mt19937 &rng) {
+  const a3c::JointAngles nominalAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  std::uniform_real_distribution<double> perturbation(-0.2, 0.2);
+  auto startAngles = nominalAngles;
+  for (auto &q : startAngles) {
+    q += perturbation(rng);
+  }
+  const auto currentPose = a3c::ForwardKinematics().fk(startAngles);
+  auto targetPose = currentPose;
+  targetPose.position += Eigen::Vector3d(0.02, -0.01, 0.01);
+  return {startAngles, currentPose, targetPose};
+}
+}  // namespace
+
+/**
+ * @brief Test the asynchronous planning service
+ * @note With the only worker busy on a first move, a later urgent request
+ * must finish before the normal ones queued ahead of it, a full queue must
+ * reject, and a cancelled request must come back as kCancelled
+ */
+TEST(IK_Test, test_planning_service) {
+  std::mt19937 rng(20);
+  a3c::PlanningServiceOptions options;
+  options.numThreads = 1;
+  options.queueCapacity = 4;
+  a3c::PlanningService service(options);
+  EXPECT_EQ(service.numThreads(), 1u);
+
+  const auto job = smallMove(rng);
+  // The only worker stays in this callback until release is set, so the
+  // queue below fills while nothing can be taken from it
+  std::promise<void> started;
+  std::promise<void> release;
+  const std::shared_future<void> released = release.get_future().share();
+  a3c::PlanResult firstResult;
+  ASSERT_TRUE(service.submit(job, a3c::PlanPriority::kNormal,
+                             [&](a3c::PlanResult &&result) {
+                               firstResult = std::move(result);
+                               started.set_value();
+                               released.wait();
+                             }));
+  started.get_future().wait();
+  EXPECT_EQ(service.queued(), 0u);
+  std::mutex orderMutex;
+  std::vector<int> order;
+  auto record = [&](int id) {
+    return [&, id](a3c::PlanResult &&result) {
+      EXPECT_EQ(result.status, a3c::PlanStatus::kSuccess);
+      std::lock_guard<std::mutex> lock(orderMutex);
+      order.push_back(id);
+    };
+  };
+  std::vector<a3c::CancelFlag> flags;
+  for (int id = 0; id < 2; ++id) {
+    flags.push_back(
+        service.submit(smallMove(rng), a3c::PlanPriority::kNormal, record(id)));
+  }
+  flags.push_back(
+      service.submit(smallMove(rng), a3c::PlanPriority::kUrgent, record(2)));
+  for (const auto &flag : flags) {
+    EXPECT_TRUE(flag);
+  }
+  a3c::PlanTicket cancelled;
+  ASSERT_TRUE(service.submit(job, a3c::PlanPriority::kNormal, cancelled));
+  cancelled.cancel();
+
+  // The queue is full with 4 requests
+  EXPECT_EQ(service.queued(), 4u);
+  size_t rejected = 0;
+  for (int i = 0; i < 8; ++i) {
+    a3c::PlanTicket ticket;
+    rejected += !service.submit(job, a3c::PlanPriority::kNormal, ticket);
+    ticket.cancel();
+  }
+  EXPECT_EQ(rejected, 8u);
+
+  EXPECT_EQ(firstResult.status, a3c::PlanStatus::kSuccess);
+  EXPECT_EQ(firstResult.trajectory,
+            a3c::InverseKinematics(job.startAngles)
+                .linearIK(job.currentPose, job.targetPose));
+  release.set_value();
+  EXPECT_EQ(cancelled.result.get().status, a3c::PlanStatus::kCancelled);
+  // Once the cancelled request is done, so are the three queued before it
+  std::lock_guard<std::mutex> lock(orderMutex);
+  ASSERT_EQ(order.size(), 3u);
+  EXPECT_EQ(order.front(), 2);
+}
+
+/**
+ * @brief Test planning through the Unix domain socket front end
+ * @note Pipelined requests must come back with their ids and the in-process
+ * trajectory, a cancelled one as kCancelled and a reused id still in flight
+ * as kRejected, even while another client leaves its results unread
+ */
+TEST(IK_Test, test_planning_socket) {
+  std::mt19937 rng(21);
+  a3c::PlanningServiceOptions options;
+  options.numThreads = 2;
+  a3c::PlanningService service(options);
+  a3c::PlanningServer server(service);
+  const std::string path = ::testing::TempDir() + "a3c-planner.sock";
+  ASSERT_TRUE(server.listen(path));
+
+  // Its results overflow the socket buffer long before the others finish
+  a3c::PlanningClient idle;
+  ASSERT_TRUE(idle.connect(path));
+  for (uint64_t id = 0; id < 32; ++id) {
+    ASSERT_TRUE(idle.send(id, smallMove(rng)));
+  }
+  a3c::PlanningClient client;
+  ASSERT_TRUE(client.connect(path));
+  std::vector<a3c::PlanJob> jobs;
+  for (uint64_t id = 0; id < 3; ++id) {
+    jobs.push_back(smallMove(rng));
+    ASSERT_TRUE(client.send(id, jobs.back()));
+  }
+  ASSERT_TRUE(client.send(3, jobs.front()));
+  ASSERT_TRUE(client.cancel(3));
+  // Queued behind the idle client's requests, so 0 is still in flight
+  ASSERT_TRUE(client.send(0, jobs.back()));
+  std::vector<bool> seen(4, false);
+  bool rejected = false;
+  for (int i = 0; i < 5; ++i) {
+    uint64_t id = 0;
+    a3c::PlanResult result;
+    ASSERT_TRUE(client.receive(id, result));
+    ASSERT_LT(id, 4u);
+    if (result.status == a3c::PlanStatus::kRejected) {
+      EXPECT_EQ(id, 0u);
+      EXPECT_FALSE(rejected);
+      rejected = true;
+      continue;
+    }
+    EXPECT_FALSE(seen[id]);
+    seen[id] = true;
+    if (id == 3) {
+      EXPECT_EQ(result.status, a3c::PlanStatus::kCancelled);
+      continue;
+    }
+    EXPECT_EQ(result.status, a3c::PlanStatus::kSuccess);
+    EXPECT_EQ(result.trajectory,
+              a3c::InverseKinematics(jobs[id].startAngles)
+                  .linearIK(jobs[id].currentPose, jobs[id].targetPose));
+  }
+  EXPECT_TRUE(rejected);
+  server.stop();
+  uint64_t id = 0;
+  a3c::PlanResult result;
+  EXPECT_FALSE(client.receive(id, result));
+  EXPECT_FALSE(a3c::PlanningClient().connect(path));
+}
+
+/**
+ * @brief Test RRT-Connect and PRM planning around a sphere
+ * @note Turning the base between start and goal sweeps the arm through the
+ * sphere, both planners must find a detour whose densified path is valid,
+ * a roadmap read back from file must answer the query the same way and one
+ * whose header counts overflow the size check must be rejected
+ */
+TEST(IK_Test, test_sampling_planner) {
+  const auto fk = a3c::ForwardKinematics();
+  const a3c::SelfCollision selfCollision(fk);
+  const a3c::IncrementalForwardKinematics prototype(fk);
+  const a3c::JointAngles nominalAngles = {
+      {-2.11696, -0.370079, -1.3761, -0.000627978, -1.3936, -2.11535}};
+  const Eigen::Vector3d center = fk.fk(nominalAngles).position;
+  const double clearance = 0.1 + 0.04;
+  const a3c::StateValidator validator = [&](const a3c::JointAngles &ja) {
+    if (selfCollision.inCollision(ja)) {
+      return false;
+    }
+    auto frames = prototype;
+    frames.update(ja);
+    for (size_t i = 0; i < a3c::IncrementalForwardKinematics::mNumLinks; ++i) {
+      const Eigen::Vector3d &p = frames.linkFrame(i).origin;
+      const Eigen::Vector3d segment = frames.linkFrame(i + 1).origin - p;
+      double t = 0.0;
+      if (segment.squaredNorm() > 0) {
+        t = (center - p).dot(segment) / segment.squaredNorm();
+        t = std::min(1.0, std::max(0.0, t));
+      }
+      if ((p + t * segment - center).norm() < clearance) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto start = nominalAngles;
+  auto goal = nominalAngles;
+  start[0] -= 1.2;
+  goal[0] += 1.2;
+  a3c::SamplingPlannerOptions options;
+  options.edgeResolution = 0.1;
+  options.numNeighbors = 6;
+  a3c::SamplingPlanner planner(validator, options);
+  ASSERT_TRUE(validator(start));
+  ASSERT_TRUE(validator(goal));
+  EXPECT_FALSE(planner.motionValid(start, goal));
+
+  const auto checkPath = [&](const std::vector<a3c::JointAngles> &path) {
+    ASSERT_GE(path.size(), 3u);
+    EXPECT_EQ(path.front(), start);
+    EXPECT_EQ(path.back(), goal);
+    for (const auto &ja : a3c::SamplingPlanner::interpolate(path, 0.02)) {
+      ASSERT_TRUE(validator(ja));
+    }
+  };
+  std::vector<a3c::JointAngles> path;
+  ASSERT_TRUE(planner.rrtConnect(start, goal, path));
+  checkPath(path);
+
+  a3c::Roadmap roadmap;
+  planner.buildRoadmap(150, roadmap);
+  EXPECT_EQ(roadmap.numNodes(), 150u);
+  EXPECT_GT(roadmap.numEdges(), 150u);
+  ASSERT_TRUE(planner.query(roadmap, start, goal, path));
+  checkPath(path);
+
+  const std::string file = ::testing::TempDir() + "a3c-roadmap.bin";
+  ASSERT_TRUE(roadmap.save(file, fk));
+  a3c::Roadmap loaded;
+  ASSERT_TRUE(loaded.load(file, fk));
+  EXPECT_EQ(loaded.offsets, roadmap.offsets);
+  EXPECT_EQ(loaded.neighbors, roadmap.neighbors);
+  std::vector<a3c::JointAngles> loadedPath;
+  ASSERT_TRUE(planner.query(loaded, start, goal, loadedPath));
+  EXPECT_EQ(loadedPath, path);
+
+  // numNeighbors follows magic, version, numJoints, dhHash and numNodes, 2^62
+  // extra neighbours add a multiple of 2^64 bytes to the expected size
+  std::fstream stream(file, std::ios::in | std::ios::out | std::ios::binary);
+  uint64_t numNeighbors = 0;
+  stream.seekg(32);
+  stream.read(reinterpret_cast<char *>(&numNeighbors), sizeof(numNeighbors));
+  numNeighbors += uint64_t{1} << 62;
+  stream.seekp(32);
+  stream.write(reinterpret_cast<const char *>(&numNeighbors),
+               sizeof(numNeighbors));
+  stream.close();
+  EXPECT_FALSE(loaded.load(file, fk));
+  EXPECT_EQ(loaded.numNodes(), 0u);
+  std::remove(file.c_str());
+}
+
+/**
+ * @brief Test time parameterization under joint limits
+ * @note A single segment must follow the closed form trapezoid, and a
+ * retimed linearIK move sampled at 1 ms must respect the velocity and
+ * acceleration limits and end on the last waypoint
+ */
+TEST(IK_Test, test_time_parameterization) {
+  a3c::KinematicLimits limits;
+  limits.maxVelocity[0] = 1;
+  limits.maxAcceleration[0] = 2;
+  a3c::TimedTrajectory timed;
+  // 0.02 rad chords put grid points, the chord midpoints, on both switches
+  ASSERT_TRUE(a3c::timeParameterize(
+      {{{0, 0, 0, 0, 0, 0}}, {{1, 0, 0, 0, 0, 0}}}, limits, timed, 0.02));
+  // 0.5 s to reach 1 rad/s over 0.25 rad, 0.5 s cruising, 0.5 s to stop
+  EXPECT_NEAR(timed.duration(), 1.5, 1E-12);
+  EXPECT_NEAR(timed.sample(0.25)[0], 0.0625, 1E-12);
+  EXPECT_NEAR(timed.sample(0.75)[0], 0.5, 1E-12);
+  EXPECT_NEAR(timed.sample(1.5)[0], 1, 1E-12);
+  a3c::KinematicLimits invalid;
+  invalid.maxAcceleration[3] = 0;
+  EXPECT_FALSE(a3c::timeParameterize(timed.waypoints, invalid, timed));
+
+  // Random straight line moves of up to 200 mm, the sampled velocities and
+  // accelerations stay within the limits without slack
+  std::mt19937 rng(23);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  std::uniform_real_distribution<double> unit(-1, 1);
+  auto fk = a3c::ForwardKinematics();
+  const a3c::KinematicLimits defaults;
+  const double period = 1E-3;
+  size_t numMoves = 0;
+  for (int move = 0; move < 40; ++move) {
+    a3c::JointAngles currentAngles;
+    for (auto &q : currentAngles) {
+      q = angle(rng);
+    }
+    const auto currentPose = fk.fk(currentAngles);
+    auto targetPose = currentPose;
+    const Eigen::Vector3d direction(unit(rng), unit(rng), unit(rng));
+    targetPose.position += 0.2 * unit(rng) * direction.normalized();
+    const auto path = a3c::InverseKinematics(currentAngles)
+                          .linearIK(currentPose, targetPose);
+    if ((fk.fk(path.back()).position - targetPose.position).norm() > 1E-3) {
+      continue;
+    }
+    ++numMoves;
+    ASSERT_TRUE(a3c::timeParameterize(path, defaults, timed));
+    EXPECT_EQ(timed.times.size(), timed.waypoints.size() + 1);
+    EXPECT_TRUE(std::is_sorted(timed.times.begin(), timed.times.end()));
+    const auto samples = timed.resample(period);
+    ASSERT_GE(samples.size(), 3u);
+    EXPECT_EQ(samples.front(), path.front());
+    EXPECT_EQ(samples.back(), path.back());
+    // The last interval is shorter than period, it is left out
+    for (size_t k = 1; k + 2 < samples.size(); ++k) {
+      for (size_t j = 0; j < path.front().size(); ++j) {
+        const double velocity = (samples[k + 1][j] - samples[k][j]) / period;
+        const double acceleration =
+            (samples[k + 1][j] - 2 * samples[k][j] + samples[k - 1][j]) /
+            (period * period);
+        EXPECT_LE(std::abs(velocity), defaults.maxVelocity[j] * (1 + 1E-6));
+        EXPECT_LE(std::abs(acceleration),
+                  defaults.maxAcceleration[j] * (1 + 1E-6));
+      }
+    }
+  }
+  EXPECT_GE(numMoves, 20u);
+}